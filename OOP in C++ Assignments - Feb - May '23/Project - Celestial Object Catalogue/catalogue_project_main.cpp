@@ -16,8 +16,8 @@ const extern std::vector<std::string> celestial_objects::luminosity_class_output
 const extern std::vector<std::string> celestial_objects::parameters_output;
 
 //Storage for keywords for the user interface
-enum class commands{Select, Create, Parent, Sort, List, Import, Export, Report, Quit, Help};
-const std::vector<std::string> commands_str{"select", "create", "parent", "sort", "list", "import", "export", "report", "quit", "help"};
+enum class commands{Select, Create, Parent, Sort, List, Import, Export, Report, Range, Cone, Neighbours, System, Quit, Help};
+const std::vector<std::string> commands_str{"select", "create", "parent", "sort", "list", "import", "export", "report", "range", "cone", "neighbours", "system", "quit", "help"};
 enum class contexts{Satellite, Catalogue, Object, All, Name, Type, Redshift, Mass, Distance, Magnitude, HubbleClass, StellarClass};
 const std::vector<std::string> command_contexts{"satellite", "catalogue", "object", "all", "name", "type", "redshift", "mass", "distance", "magnitude", "hubble_class", "stellar_class"};
 const std::vector<char> banned_name_chars{' ', '{', '}', '[', ']'};
@@ -26,20 +26,21 @@ const std::vector<char> banned_name_chars{' ', '{', '}', '[', ']'};
 //A lot easier to implement than doing a find over each object
 
 //Holds all imported catalogues of objects
-std::vector<celestial_objects::catalogue> catalogues{};
+//Selecting a catalogue shares it rather than copying it, so that changes are made to the catalogue itself and are logged and saved
+std::vector<std::shared_ptr<celestial_objects::catalogue>> catalogues{};
 
 //Used to keep track of which catalogue and object is currently selected
 //This allows for run-time selection and manipulation of objects
 std::shared_ptr<celestial_objects::catalogue> selected_catalogue_ptr;
 std::shared_ptr<celestial_objects::celestial_object> selected_object_ptr;
-std::vector<std::shared_ptr<celestial_objects::celestial_object>> selection_ptr;
+celestial_objects::catalogue_selection selection_ptr;
 
 //Controls the program, should only be "true" when quitting.
 bool quit{false};
 
 void user_interface(std::shared_ptr<celestial_objects::catalogue>& selected_catalogue, 
 std::shared_ptr<celestial_objects::celestial_object>& selected_object,
-std::vector<std::shared_ptr<celestial_objects::celestial_object>>& selection)
+celestial_objects::catalogue_selection& selection)
 {
     /* Run-time interface for users, making use of command words and context words.
     Designed to be more naturalistic than using a commandline interface (hence names are used as unique identifiers) and automatically
@@ -93,12 +94,12 @@ std::vector<std::shared_ptr<celestial_objects::celestial_object>>& selection)
             if(context == "catalogue"){
                 std::cout << "Please enter the catalogue name: ";
                 std::cin >> param_name;
-                std::vector<celestial_objects::catalogue>::iterator catalogue_position{std::find_if(catalogues.begin(),
-                catalogues.end(), [&param_name](celestial_objects::catalogue cat){return cat.get_name() == param_name;})};
+                std::vector<std::shared_ptr<celestial_objects::catalogue>>::iterator catalogue_position{std::find_if(catalogues.begin(),
+                catalogues.end(), [&param_name](const std::shared_ptr<celestial_objects::catalogue>& cat){return cat->get_name() == param_name;})};
                 if(catalogue_position >= catalogues.end()){
                     std::cout << "Catalogue not found " << std::endl;
                 } else{
-                    selected_catalogue = std::make_shared<celestial_objects::catalogue>(*catalogue_position);
+                    selected_catalogue = *catalogue_position;
                     selected_object = std::shared_ptr<celestial_objects::celestial_object>{};
                     selection.clear();
                 }
@@ -120,17 +121,25 @@ std::vector<std::shared_ptr<celestial_objects::celestial_object>>& selection)
                 } else{
                     bool valid_param{false};
                     while(!valid_param){
-                        std::cout << "Please enter the type of object you would like to select: ";
+                        std::cout << "Please enter the type of object you would like to select (separate several types with commas): ";
                         std::cin >> param_name;
-                        int position{std::find(celestial_objects::celestial_types_output.begin(), celestial_objects::celestial_types_output.end(), param_name) - celestial_objects::celestial_types_output.begin()};
-                        if (position >= celestial_objects::celestial_types_output.size()){
-                            std::cout << "Invalid type. " << std::endl;
-                        } else{
-                            valid_param = true;
-                            celestial_objects::celestial_types type{celestial_objects::celestial_types(position)};
-                            selection = selected_catalogue.get()->subselect_catalogue(type);
+                        //Every listed type is added to one mask, so that the catalogue is only scanned once
+                        celestial_objects::type_mask requested_types{0};
+                        valid_param = true;
+                        std::stringstream type_list(param_name);
+                        std::string type_name;
+                        while(std::getline(type_list, type_name, ',')){
+                            int position{std::find(celestial_objects::celestial_types_output.begin(), celestial_objects::celestial_types_output.end(), type_name) - celestial_objects::celestial_types_output.begin()};
+                            if (position >= celestial_objects::celestial_types_output.size()){
+                                std::cout << "Invalid type '" << type_name << "'. " << std::endl;
+                                valid_param = false;
+                            } else{
+                                requested_types |= celestial_objects::type_bit(celestial_objects::celestial_types(position));
+                            }
+                        }
+                        if(valid_param){
+                            selection = selected_catalogue.get()->make_selection(selected_catalogue.get()->select_types(requested_types));
                         }
-
                     }
                 }
             }
@@ -161,16 +170,15 @@ std::vector<std::shared_ptr<celestial_objects::celestial_object>>& selection)
                         }
                     }
 
-                    int name_position{std::find_if(catalogues.begin(), catalogues.end(), [&name](celestial_objects::catalogue cat)
-                    {return cat.get_name() == name;}) - catalogues.begin()};
+                    int name_position{std::find_if(catalogues.begin(), catalogues.end(), [&name](const std::shared_ptr<celestial_objects::catalogue>& cat)
+                    {return cat->get_name() == name;}) - catalogues.begin()};
                     if(name_position < catalogues.size() && name_position >= 0){
                         std::cout << "Name already taken. Please enter another name. " << std::endl;
                     } else{
                         valid_name = true;
                     }
                 }
-                celestial_objects::catalogue new_catalogue(name);
-                catalogues.push_back(new_catalogue);
+                catalogues.push_back(std::make_shared<celestial_objects::catalogue>(name));
             } else{
                 if (selected_catalogue.get() == nullptr){
                     std::cout << "No catalogue selected. Please select a catalogue" << std::endl;
@@ -184,11 +192,7 @@ std::vector<std::shared_ptr<celestial_objects::celestial_object>>& selection)
                             }
                         }
 
-                        std::vector<std::string> obj_names{selected_catalogue.get()->get_obj_names()};
-
-                        int name_position{std::find_if(obj_names.begin(), obj_names.end(), 
-                        [&name](std::string current_obj_name){return current_obj_name == name;}) - obj_names.begin()};
-                        if(obj_names.size() > 0 && name_position < obj_names.size()){
+                        if(selected_catalogue.get()->contains_object(name)){
                             std::cout << "Name already taken. Please enter another name. " << std::endl;
                         } else{
                             valid_name = true;
@@ -206,66 +210,41 @@ std::vector<std::shared_ptr<celestial_objects::celestial_object>>& selection)
                         } else if (position == 0){
                             std::cout << "Cannot create an object of the base class. " << std::endl;
                         } else{
-                            celestial_objects::catalogue local_catalogue{*selected_catalogue.get()};
                             valid_type = true;
                             celestial_objects::celestial_types object_type{celestial_objects::celestial_types(position)};
                             if(object_type == celestial_objects::celestial_types::Asteroid){
-                                celestial_objects::asteroid new_obj(name);
-                                local_catalogue.add_object(&new_obj);
+                                selected_catalogue->create_object<celestial_objects::asteroid>(name);
                             } else if(object_type == celestial_objects::celestial_types::BlackHole){
-                                celestial_objects::black_hole new_obj(name);
-                                local_catalogue.add_object(&new_obj);
+                                selected_catalogue->create_object<celestial_objects::black_hole>(name);
                             } else if(object_type == celestial_objects::celestial_types::Comet){
-                                celestial_objects::comet new_obj(name);
-                                local_catalogue.add_object(&new_obj);
+                                selected_catalogue->create_object<celestial_objects::comet>(name);
                             } else if(object_type == celestial_objects::celestial_types::DwarfPlanet){
-                                celestial_objects::dwarf_planet new_obj(name);
-                                local_catalogue.add_object(&new_obj);
+                                selected_catalogue->create_object<celestial_objects::dwarf_planet>(name);
                             } else if(object_type == celestial_objects::celestial_types::Galaxy){
-                                celestial_objects::galaxy new_obj(name);
-                                local_catalogue.add_object(&new_obj);
+                                selected_catalogue->create_object<celestial_objects::galaxy>(name);
                             } else if(object_type == celestial_objects::celestial_types::GaseousPlanet){
-                                celestial_objects::gaseous_planet new_obj(name);
-                                local_catalogue.add_object(&new_obj);
+                                selected_catalogue->create_object<celestial_objects::gaseous_planet>(name);
                             } else if(object_type == celestial_objects::celestial_types::MainSequenceStar){
-                                celestial_objects::main_sequence_star new_obj(name);
-                                local_catalogue.add_object(&new_obj);
+                                selected_catalogue->create_object<celestial_objects::main_sequence_star>(name);
                             } else if(object_type == celestial_objects::celestial_types::Moon){
-                                celestial_objects::moon new_obj(name);
-                                local_catalogue.add_object(&new_obj);
+                                selected_catalogue->create_object<celestial_objects::moon>(name);
                             } else if(object_type == celestial_objects::celestial_types::NeutronStar){
-                                celestial_objects::neutron_star new_obj(name);
-                                local_catalogue.add_object(&new_obj);
+                                selected_catalogue->create_object<celestial_objects::neutron_star>(name);
                             } else if(object_type == celestial_objects::celestial_types::Planet){
-                                celestial_objects::planet new_obj(name);
-                                local_catalogue.add_object(&new_obj);
+                                selected_catalogue->create_object<celestial_objects::planet>(name);
                             } else if(object_type == celestial_objects::celestial_types::Pulsar){
-                                celestial_objects::pulsar new_obj(name);
-                                local_catalogue.add_object(&new_obj);
+                                selected_catalogue->create_object<celestial_objects::pulsar>(name);
                             } else if(object_type == celestial_objects::celestial_types::RedGiantStar){
-                                celestial_objects::red_giant_star new_obj(name);
-                                local_catalogue.add_object(&new_obj);
+                                selected_catalogue->create_object<celestial_objects::red_giant_star>(name);
                             } else if(object_type == celestial_objects::celestial_types::Star){
-                                celestial_objects::star new_obj(name);
-                                local_catalogue.add_object(&new_obj);
+                                selected_catalogue->create_object<celestial_objects::star>(name);
                             } else if(object_type == celestial_objects::celestial_types::StellarRemnant){
-                                celestial_objects::stellar_remnant new_obj(name);
-                                local_catalogue.add_object(&new_obj);
+                                selected_catalogue->create_object<celestial_objects::stellar_remnant>(name);
                             } else if(object_type == celestial_objects::celestial_types::Supernova){
-                                celestial_objects::supernova new_obj(name);
-                                local_catalogue.add_object(&new_obj);
+                                selected_catalogue->create_object<celestial_objects::supernova>(name);
                             } else if(object_type == celestial_objects::celestial_types::TerrestrialPlanet){
-                                celestial_objects::terrestrial_planet new_obj(name);
-                                local_catalogue.add_object(&new_obj);
+                                selected_catalogue->create_object<celestial_objects::terrestrial_planet>(name);
                             }
-                        std::vector<celestial_objects::catalogue>::iterator catalogue_position{std::find_if(catalogues.begin(),
-                        catalogues.end(), [&selected_catalogue](celestial_objects::catalogue cat){return cat.get_name() == selected_catalogue->get_name();})};
-                        *catalogue_position = local_catalogue;
-                        //local_catalogue.get_object(local_catalogue.get_number() - 1)->get_additional_properties();
-                        catalogue_position = std::find_if(catalogues.begin(),
-                        catalogues.end(), [&selected_catalogue](celestial_objects::catalogue cat){return cat.get_name() == selected_catalogue->get_name();});
-                        selected_catalogue = std::make_shared<celestial_objects::catalogue>(*catalogue_position);
-                        //catalogue_position->get_object(catalogue_position->get_number()-1)->get_additional_properties();
                         }
                     }
                 }
@@ -282,12 +261,11 @@ std::vector<std::shared_ptr<celestial_objects::celestial_object>>& selection)
             } else{
                 std::cout << "Please enter the name of the object you would like to parent " << selected_object.get()->get_name() << " to: ";
                 std::cin >> name;
-                int name_position{std::find(selected_catalogue.get()->get_obj_names().begin(), selected_catalogue.get()->get_obj_names().end(), name) - selected_catalogue.get()->get_obj_names().begin()};
-                if(name_position < selected_catalogue.get()->get_obj_names().size() && name_position >= 0){
+                if(!selected_catalogue.get()->contains_object(name)){
                     std::cout << "Object does not exist. Please enter another name. " << std::endl;
                 } else{
                     try{
-                        selected_catalogue.get()->get_object(name)->add_member(selected_object);
+                        selected_catalogue.get()->add_member(name, selected_object.get()->get_name());
                     } catch(int e){
                         std::cout << "Object does not exist. Please enter another name. " << std::endl;
                     }
@@ -298,20 +276,190 @@ std::vector<std::shared_ptr<celestial_objects::celestial_object>>& selection)
 
         case commands::Import:
         {
-            celestial_objects::catalogue import_catalogue;
-            catalogues.push_back(import_catalogue);
+            catalogues.push_back(std::make_shared<celestial_objects::catalogue>());
         }
         break;
 
         case commands::Export:
         {
-            selected_catalogue.get()->export_to_file();
+            if(selected_catalogue.get() == nullptr){
+                std::cout << "No catalogue selected. Please select a catalogue. " << std::endl;
+            } else{
+                valid_command = false;
+                std::cout << "Type 'dat' to export to a pair of .dat files, 'binary' to export to a single .ccat binary file, or 'changes' to"
+                << " append only the changes since the last import or export to the catalogue's .dat files" << std::endl;
+                while (!valid_command){
+                    std::cin >> context;
+                    if(!(context == "dat" || context == "binary" || context == "changes")){
+                        std::cout << "Invalid input, please enter a valid input: ";
+                    } else{
+                        valid_command = true;
+                    }
+                }
+                if(context == "dat"){
+                    selected_catalogue.get()->export_to_file();
+                } else if(context == "changes"){
+                    selected_catalogue.get()->save_changes();
+                } else{
+                    selected_catalogue.get()->export_to_binary();
+                }
+            }
         }
         break;
 
         case commands::Report:
         {
-            selected_catalogue.get()->generate_report();
+            if(selected_catalogue.get() == nullptr){
+                std::cout << "No catalogue selected. Please select a catalogue. " << std::endl;
+            } else{
+                valid_command = false;
+                std::cout << "Type 'full' for the whole report, 'summary' for only the catalogue summary, 'paged' to show the whole report a"
+                << " page at a time, or 'file' to write the whole report to a file" << std::endl;
+                while (!valid_command){
+                    std::cin >> context;
+                    if(!(context == "full" || context == "summary" || context == "paged" || context == "file")){
+                        std::cout << "Invalid input, please enter a valid input: ";
+                    } else{
+                        valid_command = true;
+                    }
+                }
+                if(context == "file"){
+                    std::cout << "Please enter the name of the report file: ";
+                    std::cin >> name;
+                    if(selected_catalogue.get()->generate_report(name, celestial_objects::report_modes::Full)){
+                        std::cout << "Report written to '" << name << "'. " << std::endl;
+                    }
+                } else{
+                    //The rest of the line is cleared, so that paged reports wait for the user before showing each further page
+                    std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+                    int mode{int(std::find(celestial_objects::report_modes_output.begin(), celestial_objects::report_modes_output.end(), context)
+                    - celestial_objects::report_modes_output.begin())};
+                    selected_catalogue.get()->generate_report(std::cout, celestial_objects::report_modes(mode));
+                }
+            }
+        }
+        break;
+
+        case commands::Range:
+        {
+            if(selected_catalogue.get() == nullptr){
+                std::cout << "No catalogue selected. Please select a catalogue. " << std::endl;
+            } else{
+                std::string param_name;
+                std::cout << "Enter the parameter to search by ('Redshift', 'Distance', 'Mass', 'RotationalVelocity', 'RightAscension', 'Declination' or 'MemberNumber'): ";
+                std::cin >> param_name;
+                int position{std::find(celestial_objects::parameters_output.begin(), celestial_objects::parameters_output.end(), param_name) - celestial_objects::parameters_output.begin()};
+                double minimum{0};
+                double maximum{0};
+                std::cout << "Enter the lower and upper limits of the range: ";
+                std::cin >> minimum >> maximum;
+                if(std::cin.fail() || minimum > maximum){
+                    std::cin.clear();
+                    std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+                    std::cout << "Invalid range. " << std::endl;
+                } else if(position >= celestial_objects::parameters_output.size()){
+                    std::cout << "Invalid parameter" << std::endl;
+                } else{
+                    try{
+                        //The results replace the current selection, so they can be listed with 'list selection'
+                        selection = selected_catalogue.get()->range_query(celestial_objects::parameters(position), minimum, maximum);
+                        std::cout << selection.size() << " object(s) found and selected. " << std::endl;
+                    } catch(int e){
+                        std::cout << "Cannot search by parameter " << param_name << ". " << std::endl;
+                    }
+                }
+            }
+        }
+        break;
+
+        case commands::Cone:
+        {
+            if(selected_catalogue.get() == nullptr){
+                std::cout << "No catalogue selected. Please select a catalogue. " << std::endl;
+            } else{
+                double right_ascension{0};
+                double declination{0};
+                double radius{0};
+                std::cout << "Enter the right ascension and declination of the centre of the search, and its radius (all in degrees): ";
+                std::cin >> right_ascension >> declination >> radius;
+                if(std::cin.fail()){
+                    std::cin.clear();
+                    std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+                    std::cout << "Invalid cone. " << std::endl;
+                } else{
+                    try{
+                        //As with 'range', the results replace the current selection
+                        selection = selected_catalogue.get()->cone_search(right_ascension, declination, radius);
+                        std::cout << selection.size() << " object(s) found and selected. " << std::endl;
+                    } catch(int e){
+                        std::cout << "Invalid cone. Right ascension must lie within [0, 360), declination within [-90, 90] and the radius must not be negative. " << std::endl;
+                    }
+                }
+            }
+        }
+        break;
+
+        case commands::Neighbours:
+        {
+            if(selected_object.get() == nullptr){
+                std::cout << "No object selected to find the neighbours of. " << std::endl;
+            } else if(selected_catalogue.get() == nullptr){
+                std::cout << "No reference catalogue selected. Please select a catalogue. " << std::endl;
+            } else{
+                valid_command = false;
+                std::cout << "Type 'nearest' to find a number of the nearest objects to " << selected_object.get()->get_name()
+                << ", or 'within' to find every object within a distance of it" << std::endl;
+                while (!valid_command){
+                    std::cin >> context;
+                    if(!(context == "nearest" || context == "within")){
+                        std::cout << "Invalid input, please enter a valid input: ";
+                    } else{
+                        valid_command = true;
+                    }
+                }
+                double amount{0};
+                if(context == "nearest"){
+                    std::cout << "Enter the number of neighbours to find: ";
+                } else{
+                    std::cout << "Enter the distance to search within (in pc): ";
+                }
+                std::cin >> amount;
+                if(std::cin.fail() || amount < 0){
+                    std::cin.clear();
+                    std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+                    std::cout << "Invalid input. " << std::endl;
+                } else{
+                    try{
+                        //Neighbours are found in space from each object's sky position and distance, and replace the current selection
+                        int position{selected_catalogue.get()->find_position(selected_object.get()->get_name())};
+                        if(context == "nearest"){
+                            selection = selected_catalogue.get()->nearest_neighbours(position, int(amount));
+                        } else{
+                            selection = selected_catalogue.get()->neighbours_within(position, amount);
+                        }
+                        std::cout << selection.size() << " object(s) found and selected. " << std::endl;
+                    } catch(int e){
+                        std::cout << "Object does not exist in the selected catalogue. " << std::endl;
+                    }
+                }
+            }
+        }
+        break;
+
+        case commands::System:
+        {
+            if(selected_object.get() == nullptr){
+                std::cout << "No object selected to total the system of. " << std::endl;
+            } else if(selected_catalogue.get() == nullptr){
+                std::cout << "No reference catalogue selected. Please select a catalogue. " << std::endl;
+            } else{
+                try{
+                    //The totals are kept up to date by the catalogue as objects are parented, so no members are visited here
+                    selected_catalogue.get()->get_system_properties(selected_catalogue.get()->find_position(selected_object.get()->get_name()));
+                } catch(int e){
+                    std::cout << "Object does not exist in the selected catalogue. " << std::endl;
+                }
+            }
         }
         break;
 
@@ -322,29 +470,47 @@ std::vector<std::shared_ptr<celestial_objects::celestial_object>>& selection)
             std::cout << "Enter 'catalogue' to list all catalogues. " << std::endl;
             std::cout << "Enter 'objects' to list all objects in the current catalogue. " << std::endl;
             std::cout << "Enter 'selection' to get all objects in the current selection. " << std::endl;
+            std::cout << "Enter 'sorted' to list all objects in the current catalogue in order of a parameter, without sorting the catalogue. " << std::endl;
 
             while (!valid_command){
                 std::cin >> context;
-                if(!(context == "catalogue" || context == "objects" || context == "selection")){
+                if(!(context == "catalogue" || context == "objects" || context == "selection" || context == "sorted")){
                     std::cout << "Invalid input, please enter a valid input: ";
                 } else{
                     valid_command = true;
                     if(context == "catalogue"){
                         std::cout << "Catalogues: " << std::endl;
                         for(int i{0}; i < catalogues.size(); i++){
-                            std::cout << " - Name: " << catalogues[i].get_name() << ", Number of Objects: " << catalogues[i].get_number() << std::endl;
+                            std::cout << " - Name: " << catalogues[i]->get_name() << ", Number of Objects: " << catalogues[i]->get_number() << std::endl;
+                        }
+                    } else if (context == "sorted" && selected_catalogue.get() != nullptr){
+                        std::string param_name;
+                        std::cout << "Enter the parameter you would like to list the catalogue by: ";
+                        std::cin >> param_name;
+                        int position{std::find(celestial_objects::parameters_output.begin(), celestial_objects::parameters_output.end(), param_name) - celestial_objects::parameters_output.begin()};
+                        if(position < 0 || position >= celestial_objects::parameters_output.size()){
+                            std::cout << "Invalid parameter" << std::endl;
+                        } else{
+                            //The view is backed by a persistent index, so listing by the same parameter again is immediate
+                            celestial_objects::catalogue_selection sorted_objects{selected_catalogue.get()->sorted_view(celestial_objects::parameters(position))};
+                            for(int i{0}; i < sorted_objects.size(); i++){
+                                celestial_objects::celestial_object& object{sorted_objects[i]};
+                                std::cout << "- Name: " << object.get_name() << ", Type: " << celestial_objects::celestial_types_output[int(object.get_type())] << ", Child Objects: " << selected_catalogue.get()->get_member_number(sorted_objects.position(i)) << std::endl;
+                            }
                         }
                     } else if (context == "objects" && selected_catalogue.get() != nullptr){
-                        celestial_objects::celestial_types temp_type{celestial_objects::celestial_types::Unassigned};
-                        std::vector<std::shared_ptr<celestial_objects::celestial_object>> temp_vect{selected_catalogue.get()->subselect_catalogue(temp_type)};
-                        for(int i{0}; i < temp_vect.size(); i++){
-                           std::cout << "- Name: " << temp_vect[i]->get_name() << ", Type: " << celestial_objects::celestial_types_output[int(temp_vect[i]->get_type())] << ", Child Objects: " << temp_vect[i]-> get_member_number() << std::endl;
+                        //Child counts are read from the catalogue, which holds the relationships between its objects
+                        celestial_objects::catalogue_selection all_objects{selected_catalogue.get()->select_all()};
+                        for(int i{0}; i < all_objects.size(); i++){
+                           celestial_objects::celestial_object& object{all_objects[i]};
+                           std::cout << "- Name: " << object.get_name() << ", Type: " << celestial_objects::celestial_types_output[int(object.get_type())] << ", Child Objects: " << selected_catalogue.get()->get_member_number(all_objects.position(i)) << std::endl;
                         }
                     } else{
                         if(selection.size() > 0){
                             std::cout << "Selection Objects: " << std::endl;
                             for(int i{0}; i < selection.size(); i++){
-                                std::cout << "- Name: " << selection[i]->get_name() << ", Type: " << celestial_objects::celestial_types_output[int(selection[i]->get_type())] << ", Child Objects: " << selection[i]-> get_member_number() << std::endl;                                
+                                celestial_objects::celestial_object& object{selection[i]};
+                                std::cout << "- Name: " << object.get_name() << ", Type: " << celestial_objects::celestial_types_output[int(object.get_type())] << ", Child Objects: " << selection.get_catalogue()->get_member_number(selection.position(i)) << std::endl;                                
                             }
                         }
                     }
@@ -378,7 +544,7 @@ std::vector<std::shared_ptr<celestial_objects::celestial_object>>& selection)
 
         case commands::Help:
         {
-            std::cout << "Commands: 'select', 'create', 'parent', 'sort', 'list', 'import', 'export', 'quit' and 'help'." << std::endl;
+            std::cout << "Commands: 'select', 'create', 'parent', 'sort', 'list', 'import', 'export', 'report', 'range', 'cone', 'neighbours', 'system', 'quit' and 'help'." << std::endl;
             std::cout << "Object Types: 'Asteroid', 'BlackHole', 'Comet', 'Galaxy', 'Star', 'MainSequenceStar', 'RedGiantStar', 'StellarRemnant', "
             << "'NeutronStar', 'Pulsar', 'Planet', 'TerrestrialPlanet', 'GaseousPlanet', 'DwarfPlanet', 'Moon'" << std::endl;
             std::cout << "Your selections are presented as '|catalogue_name/object_name>. " << std::endl;
@@ -401,59 +567,48 @@ int main()
 
     std::cout << "Default Test Objects (in catalogue 'Test'): " << std::endl;
 
-    celestial_objects::galaxy galaxy_test("Test_Galaxy", 0, 0, std::pow(10, 12), 0.001, 0.05, celestial_objects::hubble_types::Sc);
-    galaxy_test.get_properties();
-
-    celestial_objects::asteroid aster_test("Test_Asteroid", 0, 0, 1, 0);
-    aster_test.get_properties();
+    std::shared_ptr<celestial_objects::galaxy> galaxy_test{test_catalogue.create_object<celestial_objects::galaxy>("Test_Galaxy", 0, 0, std::pow(10, 12), 0.001, 0.05, celestial_objects::hubble_types::Sc)};
+    galaxy_test->get_properties();
 
-    celestial_objects::comet comet_test("Test_Comet", 0, 0, 1, 0.0001);
-    comet_test.get_properties();
+    std::shared_ptr<celestial_objects::asteroid> aster_test{test_catalogue.create_object<celestial_objects::asteroid>("Test_Asteroid", 0, 0, 1, 0)};
+    aster_test->get_properties();
 
-    celestial_objects::dwarf_planet dplan_test("Test_Dwarf_Planet", 0, 0, 1, 0.001);
-    dplan_test.get_properties();
+    std::shared_ptr<celestial_objects::comet> comet_test{test_catalogue.create_object<celestial_objects::comet>("Test_Comet", 0, 0, 1, 0.0001)};
+    comet_test->get_properties();
 
-    celestial_objects::moon moon_test("Test_Moon", 0, 0, 1, 1);
-    moon_test.get_properties();
+    std::shared_ptr<celestial_objects::dwarf_planet> dplan_test{test_catalogue.create_object<celestial_objects::dwarf_planet>("Test_Dwarf_Planet", 0, 0, 1, 0.001)};
+    dplan_test->get_properties();
 
-    celestial_objects::main_sequence_star msstar_test("Test_Star", 0, 0, 1, 0.0002, celestial_objects::stellar_types::G, 7,
-                                                    celestial_objects::luminosity_class::IV, 1, 1);
-    msstar_test.get_properties();
+    std::shared_ptr<celestial_objects::moon> moon_test{test_catalogue.create_object<celestial_objects::moon>("Test_Moon", 0, 0, 1, 1)};
+    moon_test->get_properties();
 
-    celestial_objects::planet planet_test("Test_Planet", 0, 0, 0.00001, 0.0012);
-    planet_test.get_properties();
+    std::shared_ptr<celestial_objects::main_sequence_star> msstar_test{test_catalogue.create_object<celestial_objects::main_sequence_star>("Test_Star", 0, 0, 1, 0.0002, celestial_objects::stellar_types::G, 7,
+                                                    celestial_objects::luminosity_class::IV, 1, 1)};
+    msstar_test->get_properties();
 
-    celestial_objects::black_hole bh_test("Test_Black_Hole", 0.001, 2000, 3, 0.0012);
-    bh_test.get_properties();
+    std::shared_ptr<celestial_objects::planet> planet_test{test_catalogue.create_object<celestial_objects::planet>("Test_Planet", 0, 0, 0.00001, 0.0012)};
+    planet_test->get_properties();
 
-    celestial_objects::terrestrial_planet terrplan_test("Test_Terrestrial_Planet", 0, 200, 0.000012, 0.000074);
-    terrplan_test.get_properties();
+    std::shared_ptr<celestial_objects::black_hole> bh_test{test_catalogue.create_object<celestial_objects::black_hole>("Test_Black_Hole", 0.001, 2000, 3, 0.0012)};
+    bh_test->get_properties();
 
-    celestial_objects::gaseous_planet gasplan_test("Test_Gaseous_Planet", 0, 200, 0.000090, 0.0000004);
-    gasplan_test.get_properties();
+    std::shared_ptr<celestial_objects::terrestrial_planet> terrplan_test{test_catalogue.create_object<celestial_objects::terrestrial_planet>("Test_Terrestrial_Planet", 0, 200, 0.000012, 0.000074)};
+    terrplan_test->get_properties();
 
-    test_catalogue.add_object(&galaxy_test);
-    test_catalogue.add_object(&aster_test);
-    test_catalogue.add_object(&comet_test);
-    test_catalogue.add_object(&dplan_test);
-    test_catalogue.add_object(&moon_test);
-    test_catalogue.add_object(&msstar_test);
-    test_catalogue.add_object(&planet_test);
-    test_catalogue.add_object(&bh_test);
-    test_catalogue.add_object(&terrplan_test);
-    test_catalogue.add_object(&gasplan_test);
-
-    catalogues.push_back(test_catalogue);
+    std::shared_ptr<celestial_objects::gaseous_planet> gasplan_test{test_catalogue.create_object<celestial_objects::gaseous_planet>("Test_Gaseous_Planet", 0, 200, 0.000090, 0.0000004)};
+    gasplan_test->get_properties();
 
     try{
-        test_catalogue.get_object(6)->add_member(test_catalogue.get_object(4), 0.00000012, 4.3, 0.43);
-        test_catalogue.get_object(5)->add_member(test_catalogue.get_object(6), 0.00000416, 3.2, 0.12);
+        test_catalogue.add_member(6, 4, 0.00000012, 4.3, 0.43);
+        test_catalogue.add_member(5, 6, 0.00000416, 3.2, 0.12);
     } catch(int e){
         std::cout << "Cannot parent object. " << std::endl;
     }
+
+    catalogues.push_back(std::make_shared<celestial_objects::catalogue>(std::move(test_catalogue)));
     std::cout << "James Brady's Astronomical Catalogue Manager" << std::endl;
     std::cout << "--------------------------------------------" << std::endl;
-    std::cout << "Commands: 'select', 'create', 'parent', 'sort', 'list', 'import', 'export', 'quit' and 'help'." << std::endl;
+    std::cout << "Commands: 'select', 'create', 'parent', 'sort', 'list', 'import', 'export', 'report', 'range', 'cone', 'neighbours', 'system', 'quit' and 'help'." << std::endl;
     std::cout << "Object Types: 'Asteroid', 'BlackHole', 'Comet', 'Galaxy', 'Star', 'MainSequenceStar', 'RedGiantStar', 'StellarRemnant', "
             << "'NeutronStar', 'Pulsar', 'Planet', 'TerrestrialPlanet', 'GaseousPlanet', 'DwarfPlanet', 'Moon'" << std::endl;
     std::cout << "Your selections are presented as '|catalogue_name/object_name>. " << std::endl;
@@ -6,6 +6,15 @@
 
 #include "celestial_objects.h"
 
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/file.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
 void celestial_objects::celestial_object::add_member(std::shared_ptr<celestial_object> member_ptr, double orb_distance, double orb_tilt, double orb_eccentricity)
 {
     /* Allows a member to be added to the member_objects vector. Inspired by prior experience in using Blender's hierarchy system.
@@ -17,23 +26,18 @@ void celestial_objects::celestial_object::add_member(std::shared_ptr<celestial_o
         //This prevents any multiple ownership between non-catalogue objects and allows direct access through children/parents.
         std::cout << "Object is already parented to " << celestial_types_output[int(member_ptr->parent_object.lock().get()->object_type)] << " '" <<
         member_ptr->parent_object.lock()->name <<"'. " << std::endl;
-    } else if(member_ptr->parent_object.lock().get() == this){
+    } else if(member_ptr.get() == this){
         //Prevents an object from parenting to itself, this would be a logical paradox (as with self copy assignment)
         std::cout << "Cannot parent an object to itself! " << std::endl;
+    } else if(has_ancestor(member_ptr.get())){
+        //Whilst the use of weak_ptr prevents the cyclical error in shared_ptr instances, closed loops are still paradoxical as they are self-ownership
+        std::cout << "Cannot parent to object, illegal closed parent/child loop would be created. " << std::endl;
     } else{
-        std::shared_ptr<celestial_object> current_parent{member_ptr->parent_object.lock()};
-        while(current_parent.get() != nullptr){
-            //Iterates through chain of parents until the top parent is found (it must point to a nullptr parent)
-            current_parent = current_parent->parent_object.lock();
-        } if(current_parent.get() == member_ptr.get()){
-            //Whilst the use of weak_ptr prevents the cyclical error in shared_ptr instances, closed loops are still paradoxical as they are self-ownership
-            std::cout << "Cannot parent to object, illegal closed parent/child loop would be created. " << std::endl;
-        } else{
-            //Adds the satellite to the array of member satellites
-            satellite sat(member_ptr, orb_distance, orb_tilt, orb_eccentricity);
-            member_objects.push_back(sat);
-            member_number++;
-        }
+        //Adds the satellite to the array of member satellites
+        satellite sat(member_ptr, orb_distance, orb_tilt, orb_eccentricity);
+        member_objects.push_back(sat);
+        member_number++;
+        member_ptr->parent_object = weak_from_this();
     }
 }
 
@@ -42,39 +46,56 @@ void celestial_objects::celestial_object::add_member(std::shared_ptr<celestial_o
     if(member_ptr.get()->parent_object.lock() != nullptr){
         std::cout << "Object is already parented to " << celestial_types_output[int(member_ptr.get()->parent_object.lock().get()->get_type())] << " '" <<
         member_ptr.get()->parent_object.lock().get()->get_name() <<"'. " << std::endl;
-    } else if(member_ptr.get()->parent_object.lock().get() == this){
+    } else if(member_ptr.get() == this){
         std::cout << "Cannot parent an object to itself! " << std::endl;
+    } else if(has_ancestor(member_ptr.get())){
+        std::cout << "Cannot parent to object, illegal closed parent/child loop would be created. " << std::endl;
     } else{
-        std::shared_ptr<celestial_object> current_parent{member_ptr->parent_object.lock()};
-        while(current_parent.get() != nullptr){
-            current_parent = current_parent->parent_object.lock();
-        } if(current_parent.get() == member_ptr.get()){
-            std::cout << "Cannot parent to object, illegal closed parent/child loop would be created. " << std::endl;
-        } else{
-            satellite sat(member_ptr);
-            member_objects.push_back(sat);
-            member_number++;
+        satellite sat(member_ptr);
+        member_objects.push_back(sat);
+        member_number++;
+        member_ptr->parent_object = weak_from_this();
+    }
+}
+
+bool celestial_objects::celestial_object::has_ancestor(const celestial_object* object) const
+{
+    /* Checks whether an object is above this one in its chain of parents. Objects held in a catalogue are linked through the
+    catalogue's own hierarchy store, which answers this without a walk, so this is only used for objects linked directly. */
+    for(std::shared_ptr<celestial_object> current_parent{parent_object.lock()}; current_parent != nullptr; current_parent = current_parent->parent_object.lock()){
+        if(current_parent.get() == object){
+            return true;
         }
     }
+    return false;
 }
 
-void celestial_objects::celestial_object::export_to_file(std::fstream& object_dat, std::fstream& relation_dat)
+void celestial_objects::celestial_object::export_to_file(export_buffer& object_data, export_buffer& relation_data)
 {
-    /* Converts the object data and the object's relationships into strings that can be parsed by the catalogue import function.
-    These strings are then written to the relevant files. */
-    std::stringstream data_string;
-    std::stringstream relationship_string;
-    data_string << celestial_types_output[int(object_type)] << ":" << name << ":" << redshift << ":" << distance << ":" <<
-    mass << ":" << rotational_velocity << '\n';
-    object_dat.write(data_string.str().c_str(), data_string.str().size());
+    /* Formats the object data and the object's relationships into lines that can be parsed by the catalogue import function.
+    These lines are then added to the relevant buffers. */
+    object_data << celestial_types_output[int(object_type)] << ":" << name << ":" << redshift << ":" << distance << ":" <<
+    mass << ":" << rotational_velocity << ":" << right_ascension << ":" << declination << '\n';
+    export_relationships(relation_data);
+}
+
+void celestial_objects::celestial_object::export_relationships(export_buffer& relation_data)
+{
+    //Iterates over all children in the member array to produce their relationship data, one line each
+    //As we know that objects may only have one parent, if all objects are exported, all relationships will be captured
+    for(int i{0}; i < int(member_objects.size()); i++){
+        export_relationship(relation_data, i);
+    }
+}
 
-    for(int i{0}; i < member_number; i++){
-        //Iterates over all children in the member array to produce their relationship data
-        //As we know that objects may only have one parent, if all objects are exported, all relationships will be captured
-        satellite current_satellite{member_objects[i]};
-        relationship_string << name << ":" << current_satellite.get_object()->name << ":" << current_satellite.orbit_distance <<
-        ":" << current_satellite.orbit_tilt << ":" << current_satellite.orbit_eccentricity << '\n';
-        relation_dat.write(relationship_string.str().c_str(), data_string.str().size());
+void celestial_objects::celestial_object::export_relationship(export_buffer& relation_data, int index)
+{
+    //Formats the relationship with the member at the given index, skipping members that no longer exist
+    const satellite& current_satellite{member_objects[index]};
+    std::shared_ptr<celestial_object> child{current_satellite.satellite_object.lock()};
+    if(child.get() != nullptr){
+        relation_data << name << ":" << child->name << ":" << current_satellite.orbit_distance << ":" << current_satellite.orbit_tilt
+        << ":" << current_satellite.orbit_eccentricity << '\n';
     }
 }
 
@@ -117,6 +138,7 @@ celestial_objects::satellite celestial_objects::celestial_object::get_member(int
     } else{
         std::cout << "Object index " << index << " out of range for member_objects, size " << member_number << " ," << std::endl;
         std::cout << "Object not returned. " << std::endl;
+        throw(-1);
     }
 }
 
@@ -124,26 +146,43 @@ void celestial_objects::celestial_object::get_properties()
 {
     /* Will output the properties contained by any celestial object. A function to return derived class-specific
     properties is also included. */
-
-    std::cout << "Name: " << name << std::endl;
-    std::cout << "Object Type: " << celestial_types_output[int(object_type)] << std::endl;
-    std::cout << "Mass: " << mass << " M_Sun" << std::endl;
-    std::cout << "Rotational Velocity: " << rotational_velocity << " rads^-1" << std::endl;
-    std::cout << "Distance from Solar System: " << distance << " pc" << std::endl;
-    std::cout << "Redshift: " << redshift << std::endl;
-    //Returns class-specific properties if present (as in galaxy objects and star object derivatives)
-    this->get_additional_properties();
+    //The lines are collected in a buffer and written to the console together, rather than flushing the console for each
+    export_buffer report_data;
+    write_properties(report_data);
     if(member_objects.size() > 0){
-        std::cout << "Children: " << std::endl;
+        report_data << "Children: \n";
         for(std::vector<celestial_objects::satellite>::iterator i{member_objects.begin()}; i < member_objects.end(); i++){
-            std::cout << "- Name: " << i->get_object()->get_name() << ", Type: " << celestial_types_output[int(i->get_object()->get_type())] 
-            << ", Number of Children: " << i->get_object()->get_member_number() << std::endl;
-            std::cout << "  Orbital Distance: " << i->orbit_distance << " pc, Orbital Tilt: " << i->orbit_tilt << " deg, Orbital Eccentricity: " << i->orbit_eccentricity << std::endl;
+            report_data << "- Name: " << i->get_object()->get_name() << ", Type: " << celestial_types_output[int(i->get_object()->get_type())] 
+            << ", Number of Children: " << i->get_object()->get_member_number() << '\n';
+            report_data << "  Orbital Distance: " << i->orbit_distance << " pc, Orbital Tilt: " << i->orbit_tilt << " deg, Orbital Eccentricity: " << i->orbit_eccentricity << '\n';
         }
     } else{
-        std::cout << "No child objects. " << std::endl;
+        report_data << "No child objects. \n";
     }
-    std::cout << "---------------------------" << std::endl;
+    report_data << "---------------------------\n";
+    std::cout << report_data.contents() << std::flush;
+}
+
+void celestial_objects::celestial_object::get_object_properties()
+{
+    //Outputs the object's own properties, leaving its children to be listed by whichever hierarchy the object belongs to
+    export_buffer report_data;
+    write_properties(report_data);
+    std::cout << report_data.contents() << std::flush;
+}
+
+void celestial_objects::celestial_object::write_properties(export_buffer& report_data)
+{
+    //Formats the object's own properties into a buffer, one per line, as they are output by get_object_properties()
+    report_data << "Name: " << name << '\n';
+    report_data << "Object Type: " << celestial_types_output[int(object_type)] << '\n';
+    report_data << "Mass: " << mass << " M_Sun\n";
+    report_data << "Rotational Velocity: " << rotational_velocity << " rads^-1\n";
+    report_data << "Distance from Solar System: " << distance << " pc\n";
+    report_data << "Sky Position: RA " << right_ascension << " deg, Dec " << declination << " deg\n";
+    report_data << "Redshift: " << redshift << '\n';
+    //Returns class-specific properties if present (as in galaxy objects and star object derivatives)
+    this->write_additional_properties(report_data);
 }
 
 std::vector<celestial_objects::satellite> celestial_objects::celestial_object::get_all_members()
@@ -158,67 +197,71 @@ std::shared_ptr<celestial_objects::celestial_object> celestial_objects::satellit
     return satellite_object.lock();
 }
 
-void celestial_objects::galaxy::export_to_file(std::fstream& object_dat, std::fstream& relation_dat)
+void celestial_objects::galaxy::export_to_file(export_buffer& object_data, export_buffer& relation_data)
 {
-    /* Converts the object data and the object's relationships into strings that can be parsed by the catalogue import function.
-    These strings are then written to the relevant files. */
-    //NEED TO OVERRIDE FOR STARS AND GALAXIES AND THEN I CAN TEST
-    std::stringstream data_string;
-    std::stringstream relationship_string;
-    data_string << celestial_types_output[int(object_type)] << ":" << name << ":" << redshift << ":" << distance << ":" <<
-    mass << ":" << rotational_velocity << ":" << stellar_mass_fraction << ":" << hubble_types_output[int(hubble_type)] << '\n';
-    object_dat.write(data_string.str().c_str(), data_string.str().size());
+    /* Formats the object data, including the galaxy parameters, and the object's relationships into lines that can be parsed by
+    the catalogue import function. */
+    object_data << celestial_types_output[int(object_type)] << ":" << name << ":" << redshift << ":" << distance << ":" <<
+    mass << ":" << rotational_velocity << ":" << stellar_mass_fraction << ":" << hubble_types_output[int(hubble_type)] << ":" <<
+    right_ascension << ":" << declination << '\n';
+    export_relationships(relation_data);
+}
 
-    for(int i{0}; i < member_number; i++){
-        //Iterates over all children in the member array to produce their relationship data
-        //As we know that objects may only have one parent, if all objects are exported, all relationships will be captured
-        satellite current_satellite{member_objects[i]};
-        relationship_string << name << ":" << current_satellite.get_object()->get_name() << ":" << current_satellite.orbit_distance <<
-        ":" << current_satellite.orbit_tilt << ":" << current_satellite.orbit_eccentricity << '\n';
-        relation_dat.write(relationship_string.str().c_str(), data_string.str().size());
-    }
+void celestial_objects::galaxy::write_additional_properties(export_buffer& report_data)
+{
+    report_data << "Hubble Type: " << hubble_types_output[int(hubble_type)] << '\n';
+    report_data << "Stellar Mass Fraction: " << stellar_mass_fraction << '\n';
 }
 
-void celestial_objects::galaxy::get_additional_properties()
+void celestial_objects::star::export_to_file(export_buffer& object_data, export_buffer& relation_data)
 {
-    std::cout << "Hubble Type: " << hubble_types_output[int(hubble_type)] << std::endl;
-    std::cout << "Stellar Mass Fraction: " << stellar_mass_fraction << std::endl;
+    /* Formats the object data, including the stellar parameters, and the object's relationships into lines that can be parsed by
+    the catalogue import function. */
+    object_data << celestial_types_output[int(object_type)] << ":" << name << ":" << redshift << ":" << distance << ":" <<
+    mass << ":" << rotational_velocity << ":" << stellar_types_output[int(star_type)] << ":" << stellar_digit << ":" <<
+    luminosity_class_output[int(luminosity_id)] << ":" << abs_magnitude << ":" << app_magnitude << ":" << right_ascension << ":" <<
+    declination << '\n';
+    export_relationships(relation_data);
 }
 
-void celestial_objects::star::export_to_file(std::fstream& object_dat, std::fstream& relation_dat)
+void celestial_objects::star::write_additional_properties(export_buffer& report_data)
 {
-    /* Converts the object data and the object's relationships into strings that can be parsed by the catalogue import function.
-    These strings are then written to the relevant files. */
-    //NEED TO OVERRIDE FOR STARS AND GALAXIES AND THEN I CAN TEST
-    std::stringstream data_string;
-    std::stringstream relationship_string;
-    data_string << celestial_types_output[int(object_type)] << ":" << name << ":" << redshift << ":" << distance << ":" <<
-    mass << ":" << rotational_velocity << ":" << stellar_types_output[int(star_type)] << ":" << stellar_digit << ":" << 
-    luminosity_class_output[int(luminosity_id)] << ":" << abs_magnitude << ":" << app_magnitude << '\n';
-    object_dat.write(data_string.str().c_str(), data_string.str().size());
+    report_data << "Stellar Classification: " << stellar_types_output[int(star_type)] << stellar_digit 
+                << luminosity_class_output[int(luminosity_id)] << '\n';
+    report_data << "Magnitudes: " << abs_magnitude << " (absolute), " << app_magnitude << " (apparent)\n";
+}
 
-    for(int i{0}; i < member_number; i++){
-        //Iterates over all children in the member array to produce their relationship data
-        //As we know that objects may only have one parent, if all objects are exported, all relationships will be captured
-        satellite current_satellite{member_objects[i]};
-        relationship_string << name << ":" << current_satellite.get_object()->get_name() << ":" << current_satellite.orbit_distance <<
-        ":" << current_satellite.orbit_tilt << ":" << current_satellite.orbit_eccentricity << '\n';
-        relation_dat.write(relationship_string.str().c_str(), data_string.str().size());
-    }
+void celestial_objects::planet::write_additional_properties(export_buffer& report_data)
+{
+    report_data << "No additional properties. \n";
+}
+
+void celestial_objects::moon::write_additional_properties(export_buffer& report_data)
+{
+    report_data << "No additional properties. \n";
+}
+
+void celestial_objects::comet::write_additional_properties(export_buffer& report_data)
+{
+    report_data << "No additional properties. \n";
+}
+
+void celestial_objects::asteroid::write_additional_properties(export_buffer& report_data)
+{
+    report_data << "No additional properties. \n";
 }
 
-void celestial_objects::star::get_additional_properties()
+void celestial_objects::black_hole::write_additional_properties(export_buffer& report_data)
 {
-    std::cout << "Stellar Classification: " << stellar_types_output[int(star_type)] << stellar_digit 
-                << luminosity_class_output[int(luminosity_id)] << std::endl;
-    std::cout << "Magnitudes: " << abs_magnitude << " (absolute), " << app_magnitude << " (apparent)" << std::endl;
+    report_data << "No additional properties. \n";
 }
 
 void celestial_objects::catalogue::import_from_file()
 {
     //Creates file storage, logical flags and an input
-    std::fstream object_data;
-    std::fstream relationship_data;
+    //Both files are mapped into memory and parsed in place rather than read line by line into strings
+    mapped_file object_data;
+    mapped_file relationship_data;
     bool file_read_success{false};
     bool relations_read_success{false};
     std::string file_name{""};
@@ -226,25 +269,33 @@ void celestial_objects::catalogue::import_from_file()
     //Loads in the object and relationship files
     //Modified from the basis used in the grades assignent
     while (!file_read_success){
-        std::cout << "Enter the filename or path of your .dat file: ";
+        std::cout << "Enter the filename or path of your .dat or .ccat file: ";
         std::getline(std::cin, file_name);
-        object_data.open(file_name);
-        if (!object_data.good()){
+        if(file_name.size() > 5 && file_name.compare(file_name.size() - 5, 5, ".ccat") == 0){
+            //Binary catalogues hold their relationships in the same file, so are loaded separately
+            if(import_from_binary(file_name)){
+                return;
+            }
+        } else if (!object_data.open(file_name)){
             //If the file doesn't exist, it is not loaded and the user is allowed to reenter the path/name
             std::cout << "File or file directory '" << file_name << "' does not exist." << std::endl;
             std::cout << std::endl;
         } else{
             std::cout << "File found successfully!" << std::endl;
             file_read_success = true;
+            //Changes to the catalogue can later be appended to the file it was loaded from
+            save_path = file_name;
             //Returns 0 if not found => first character used, otherwise gives position of start of file name in path
-            int catalogue_name_begin{file_name.find_last_of("/") + 1};
-            //-4 accounts for '.dat' extension, hence we are left with the non .dat part of the file name.
-            catalogue_name = file_name.substr(catalogue_name_begin, (file_name.length()-4));
-            //Modifies the file path to find the relationship data
-            int insertion_position{file_name.rfind(".dat")};
-            file_name.insert(insertion_position, "_relationships");
-            relationship_data.open(file_name);
-            if(!relationship_data.good()){
+            std::size_t catalogue_name_begin{file_name.find_last_of("/") + 1};
+            //Modifies the file path to find the relationship data, inserting before the '.dat' extension if there is one
+            std::size_t insertion_position{file_name.rfind(".dat")};
+            if(insertion_position == std::string::npos){
+                insertion_position = file_name.length();
+            }
+            //Removing the '.dat' extension leaves the name of the catalogue
+            catalogue_name = file_name.substr(catalogue_name_begin, insertion_position - catalogue_name_begin);
+            file_name = relationship_file_name(file_name);
+            if(!relationship_data.open(file_name)){
                 //Still allows the objects to be loaded in, but still provides a warning if the file is not found
                 std::cout << "Object relationship data not found." << std::endl;
                 std::cout << "Objects will require manual parenting." << std::endl;
@@ -255,580 +306,3381 @@ void celestial_objects::catalogue::import_from_file()
         }
     }
 
-    std::string line;
     //Parser for object data
-    bool import_data{true};
-    while(std::getline(object_data, line) && import_data){
-        if(object_data.eof()){
-            import_data = false;
-        } else{
-            std::string parameter;
-            std::vector<std::string> parameter_storage;
-            celestial_types object_type{celestial_types::Unassigned};
-            std::string object_name;
-            double object_redshift;
-            double object_distance;
-            double object_mass;
-            double object_omega;
-            std::shared_ptr<celestial_object> object_ptr{nullptr};
-            bool read{true};
-
-            while(read){
-                //Parameters are delimited by a ':' char within the object file
-                //Found parameters are added as strings to a vector of strings
-                int break_point{line.find(":")};
-                parameter = line.substr(0, break_point);
-                parameter_storage.push_back(parameter);
-                if(break_point == -1){
-                    read = false;
-                } else{
-                    line.erase(0, break_point+1);
-                }
-            }
+    //The object file is split into chunks at line boundaries which are parsed on separate threads
+    std::string_view object_text{object_data.contents()};
+    //Changes appended by save_changes() follow the first delta marker, and are replayed in order once the rest of the file is loaded
+    std::string_view delta_text{};
+    std::size_t delta_begin{object_text.find("\n#delta")};
+    if(object_text.substr(0, 6) == "#delta"){
+        delta_begin = 0;
+    } else if(delta_begin != std::string_view::npos){
+        delta_begin++;
+    }
+    if(delta_begin != std::string_view::npos){
+        delta_text = object_text.substr(delta_begin);
+        object_text = object_text.substr(0, delta_begin);
+    }
+    //The files were last saved by the highest numbered delta in either of them, which the operation log is checked against
+    save_sequence = delta_sequence(delta_text);
+    int worker_number{choose_worker_count(object_text.size(), 1 << 20)};
+    std::vector<import_chunk> chunks(worker_number);
+    for(int i{0}; i < worker_number; i++){
+        std::size_t chunk_end{object_text.size()};
+        if(i < worker_number - 1){
+            //Moves the nominal end of the chunk forward to the next newline so that no line is split between two workers
+            chunk_end = object_text.find('\n', std::min(object_text.size() / std::size_t(worker_number - i), object_text.size()));
+            chunk_end = (chunk_end == std::string_view::npos) ? object_text.size() : chunk_end + 1;
+        }
+        chunks[i].text = object_text.substr(0, chunk_end);
+        object_text.remove_prefix(chunk_end);
+    }
 
-            try{
-                //Attemped conversion from parameter strings into useful paremeters
-                //If this fails, it is clear that the .dat file loaded in was not configured for this program or there is an error in the file
-                //Where possible, data files should be generated by this program via the export_to_file() method and then read in as needed in subsequent sessions.
-                std::string object_type_str{parameter_storage[0]};
-                int position{std::find(celestial_types_output.begin(), celestial_types_output.end(), object_type_str) - celestial_types_output.begin()};
-                object_type = celestial_types(position);
-
-                object_name = parameter_storage[1];
-                local_object_names.push_back(object_name);
-                object_redshift = std::stod(parameter_storage[2]);
-                object_distance = std::stod(parameter_storage[3]);
-                object_mass = std::stod(parameter_storage[4]);
-                object_omega = std::stod(parameter_storage[5]);
-
-                if(object_type == celestial_types::Galaxy){
-                    //Handles a galaxy object due to its unique parameters
-                    //There is only one type of galaxy object, so no switch statement is required for construction
-                    double object_mass_frac{std::stod(parameter_storage[6])};
-
-                    std::string hubble_type_str{parameter_storage[7]};
-                    position = int(std::find(hubble_types_output.begin(), hubble_types_output.end(), hubble_type_str) - hubble_types_output.begin());
-                    hubble_types object_htype{hubble_types(position)};
-
-                    galaxy object(object_name, object_redshift, object_distance, object_mass, object_omega, object_mass_frac, object_htype);
-                    object_ptr = std::make_shared<galaxy>(object);
-
-                } else if(object_type == celestial_types::Star || object_type == celestial_types::MainSequenceStar || object_type == celestial_types::RedGiantStar 
-                || object_type == celestial_types::StellarRemnant || object_type == celestial_types::NeutronStar ||  object_type == celestial_types::Pulsar){
-                    //Handles stellar objects and parses their extra paremeters
-                    //The default case does not throw an error, as we know from the else if above that the type must be within those checked by the else if() above.
-                    std::string stel_type_str{parameter_storage[6]};
-                    position = int(std::find(stellar_types_output.begin(), stellar_types_output.end(), stel_type_str) - stellar_types_output.begin());
-                    stellar_types stel_type{stellar_types(position)};
-
-                    int stel_digit{std::stoi(parameter_storage[7])};
-
-                    std::string lum_no_str{(parameter_storage[8])};
-                    position = int(std::find(luminosity_class_output.begin(), luminosity_class_output.end(), lum_no_str) - luminosity_class_output.begin());
-                    luminosity_class lum_no{luminosity_class(position)};
-
-                    double absolute_lum{std::stod(parameter_storage[9])};
-                    double apparent_lum(std::stod(parameter_storage[10]));
-
-                    //Whilst extensive, this switch handles the construction of individual objects via identification of object type
-                    switch(object_type)
-                    {
-                        //Handles all stellar objects as they have more parameters due to being luminous
-                        case celestial_types::RedGiantStar:
-                        {
-                            red_giant_star object(object_name, object_redshift, object_distance, object_mass, object_omega, stel_type,
-                            stel_digit, lum_no, absolute_lum, apparent_lum);
-                            object_ptr = std::make_shared<red_giant_star>(object);
-                        }
-                        break;
-
-                        case celestial_types::MainSequenceStar:
-                        {
-                            main_sequence_star object(object_name, object_redshift, object_distance, object_mass, object_omega, stel_type,
-                            stel_digit, lum_no, absolute_lum, apparent_lum);
-                            object_ptr = std::make_shared<main_sequence_star>(object);
-                        }
-                        break;
-
-                        case celestial_types::NeutronStar:
-                        {
-                            neutron_star object(object_name, object_redshift, object_distance, object_mass, object_omega, stel_type,
-                            stel_digit, lum_no, absolute_lum, apparent_lum);
-                            object_ptr = std::make_shared<neutron_star>(object);
-                        }
-                        break;
-
-                        case celestial_types::Pulsar:
-                        {
-                            pulsar object(object_name, object_redshift, object_distance, object_mass, object_omega, stel_type,
-                            stel_digit, lum_no, absolute_lum, apparent_lum);
-                            object_ptr = std::make_shared<pulsar>(object);
-                        }
-                        break;
-
-                        case celestial_types::StellarRemnant:
-                        {
-                            stellar_remnant object(object_name, object_redshift, object_distance, object_mass, object_omega, stel_type,
-                            stel_digit, lum_no, absolute_lum, apparent_lum);
-                            object_ptr = std::make_shared<stellar_remnant>(object);                                    
-                        }
-                        break;
-
-                        default:
-                        {
-                            star object(object_name, object_redshift, object_distance, object_mass, object_omega, stel_type,
-                            stel_digit, lum_no, absolute_lum, apparent_lum);
-                            object_ptr = std::make_shared<star>(object);                                    
-                        }
-                        break;                                
-                    }
-                } else{
-                    //Handles all other derived classes not derived from the star class
-                    switch (object_type)
-                    {
-                        case celestial_types::Asteroid:
-                        {
-                            asteroid object(object_name, object_redshift, object_distance, object_mass, object_omega);
-                            object_ptr = std::make_shared<asteroid>(object);
-                        }
-                        break;
-                
-                        case celestial_types::BlackHole:
-                        {
-                            black_hole object(object_name, object_redshift, object_distance, object_mass, object_omega);
-                            object_ptr = std::make_shared<black_hole>(object);
-                        }
-                        break;
-                
-                        case celestial_types::Comet:
-                        {
-                            comet object(object_name, object_redshift, object_distance, object_mass, object_omega);
-                            object_ptr = std::make_shared<comet>(object);
-                        }
-                        break;
-                
-                        case celestial_types::DwarfPlanet:
-                        {
-                            dwarf_planet object(object_name, object_redshift, object_distance, object_mass, object_omega);
-                            object_ptr = std::make_shared<dwarf_planet>(object);
-                        }
-                        break;
-                
-                        case celestial_types::GaseousPlanet:
-                        {
-                            gaseous_planet object(object_name, object_redshift, object_distance, object_mass, object_omega);
-                            object_ptr = std::make_shared<gaseous_planet>(object);
-                        }
-                        break;
-                
-                        case celestial_types::Moon:
-                        {
-                            moon object(object_name, object_redshift, object_distance, object_mass, object_omega);
-                            object_ptr = std::make_shared<moon>(object);
-                        }
-                        break;
-                
-                        case celestial_types::Planet:
-                        {
-                            planet object(object_name, object_redshift, object_distance, object_mass, object_omega);
-                            object_ptr = std::make_shared<planet>(object);
-                        }
-                        break;
-                
-                        case celestial_types::TerrestrialPlanet:
-                        {
-                            terrestrial_planet object(object_name, object_redshift, object_distance, object_mass, object_omega);
-                            object_ptr = std::make_shared<terrestrial_planet>(object);
-                        }
-                        break;
-                
-                        default:
-                        {
-                            //If all else fails and an object cannot be created, an error will be thrown by default.
-                            throw int{-1};
-                        }
-                        break;
-                    }
-                }
+    //The first chunk is parsed on the calling thread whilst the others are handled by the workers
+    std::vector<std::thread> workers;
+    for(int i{1}; i < worker_number; i++){
+        workers.emplace_back(&catalogue::parse_object_chunk, this, std::ref(chunks[i]));
+    }
+    parse_object_chunk(chunks[0]);
+    for(std::thread& worker : workers){
+        worker.join();
+    }
 
-                catalogue_objects.push_back(std::shared_ptr<celestial_object>{object_ptr});
-                object_amount++;     
-            } catch(std::bad_alloc){
-                //Whilst unlikely on modern hardware, this will catch any cases where there is not enough memory left in RAM to assign an object.
-                std::cout << "Not enough memory available to allocate to object." << std::endl;
-            } catch(std::invalid_argument const& exception){
-                //This should handle bad assignments due to incorrect data
-                //Theoretically, if this isn't thrown the constructor for each class SHOULD work.
-                std::cout << "ERROR: " << exception.what() << std::endl;
-            } catch(int i){
-                std::cout << "Unable to create object of unknown type  " << parameter_storage[0] << " ." << std::endl;
-            }
+    //Merges the chunks in file order, so that the catalogue order is the same as a serial import
+    indexes_deferred = true;
+    std::size_t parsed_number{0};
+    for(import_chunk& chunk : chunks){
+        parsed_number += chunk.objects.size();
+    }
+    reserve_objects(parsed_number);
+    for(import_chunk& chunk : chunks){
+        std::cout << chunk.messages;
+        for(std::shared_ptr<celestial_object>& object_ptr : chunk.objects){
+            //Names are only registered once the object has been constructed, so that the name index never points at a missing object
+            register_object(std::move(object_ptr));
         }
     }
+    replay_object_deltas(delta_text);
+    std::string_view line;
 
     //As above, but parses data for relationships from its corresponding file to construct the parent/child hierarchy.
     //This will not run if the relationships data file is not found.
-    if(relationship_data.good()){
-        bool import_relationships{true};
-        while(std::getline(relationship_data, line) && import_relationships){
-            if(relationship_data.eof()){
-                import_relationships = false;
-            } else{
-                std::string parameter;
-                std::vector<std::string> parameter_storage;
-                celestial_types object_type{celestial_types::Unassigned};
-                std::string parent_name;
-                std::string child_name;
-                double orbital_distance;
-                double orbital_tilt;
-                double orbital_eccentricity;
-                std::shared_ptr<celestial_object> parent_ptr{nullptr};
-                std::shared_ptr<celestial_object> child_ptr{nullptr};
-
-                //HERE'S THE GDAMN ISSUE
-                bool read{true};
-                while(read){
-                    int break_point{line.find(":")};
-                    parameter = line.substr(0, break_point);
-                    parameter_storage.push_back(parameter);
-                    if(break_point == -1){
-                        read = false;
-                    } else{
-                        line.erase(0, break_point+1);
-                    }
+    if(relations_read_success){
+        //Names that could not be matched to an object are counted rather than reported individually
+        int unresolved_names{0};
+        std::string_view relationship_text{relationship_data.contents()};
+        //Relationships are gathered and then made together, which checks them all in one pass
+        std::vector<object_relationship> relationships;
+        relationships.reserve(std::size_t(std::count(relationship_text.begin(), relationship_text.end(), '\n')) + 1);
+        std::array<std::string_view, max_line_fields> fields;
+        while(next_line(relationship_text, line)){
+            //Delta markers only need their numbers read, as relationships are only ever added
+            if(line.empty()){
+                continue;
+            } else if(line.front() == '#'){
+                save_sequence = std::max(save_sequence, delta_sequence(line));
+                continue;
+            }
+            try{
+                if(split_fields(line, fields) < 5){
+                    throw std::invalid_argument("Relationship line '" + std::string(line) + "' has too few fields.");
                 }
+                double orbital_distance{parse_double(fields[2])};
+                double orbital_tilt{parse_double(fields[3])};
+                double orbital_eccentricity{parse_double(fields[4])};
 
-                parent_name = parameter_storage[0];
-                child_name = parameter_storage[1];
-                orbital_distance = std::stod(parameter_storage[2]);
-                orbital_tilt = std::stod(parameter_storage[3]);
-                orbital_eccentricity = std::stod(parameter_storage[4]);
-
-                //Object names are used as their unique identifiers, hence the current_object_names vector in the main .cpp file
+                //Object names are used as their unique identifiers, and the name index was filled in during the object pass
                 //If an object with a certain name cannot be found in the catalogue, it does not exist and hence cannot be made a parent/child
-                std::vector<std::shared_ptr<celestial_object>>::iterator parent_position{std::find_if(catalogue_objects.begin(),
-                catalogue_objects.end(), [&parent_name](const std::shared_ptr<celestial_object> ptr){return ptr.get()->get_name() == parent_name;})};
-                std::vector<std::shared_ptr<celestial_object>>::iterator child_position{std::find_if(catalogue_objects.begin(),
-                catalogue_objects.end(), [&child_name](const std::shared_ptr<celestial_object> ptr){return ptr.get()->get_name() == child_name;})};
-                if(parent_position == catalogue_objects.end()){
-                    std::cout << "Cannot find parent object '" << parent_name << "'." << std::endl;
-                } else if(child_position == catalogue_objects.end()){
-                    std::cout << "Cannot find child object '" << child_name << "'." << std::endl;
+                int parent_position{find_position(fields[0])};
+                int child_position{find_position(fields[1])};
+                if(parent_position == -1 || child_position == -1){
+                    unresolved_names += int(parent_position == -1) + int(child_position == -1);
                 } else{
-                    //Creates a satellite object within the parent object's member_objects array, pointing to the child object, given that they both exist
-                    parent_ptr = *parent_position;
-                    child_ptr = *child_position;
-                    parent_ptr->add_member(child_ptr, orbital_distance, orbital_tilt, orbital_eccentricity);
+                    relationships.push_back(object_relationship{parent_position, child_position, orbital_distance, orbital_tilt, orbital_eccentricity});
                 }
+            } catch(std::invalid_argument const& exception){
+                std::cout << "ERROR: " << exception.what() << std::endl;
             }
         }
+        //Adds an edge from each parent to its child to the catalogue's hierarchy store, given that they both exist
+        report_link_errors(link_all(relationships));
+        if(unresolved_names > 0){
+            std::cout << unresolved_names << " object name(s) in the relationship data could not be found in the catalogue. " << std::endl;
+            std::cout << "Relationships involving these objects have not been created. " << std::endl;
+        }
     }
-    //Makes sure that the files are closed and hence memory is released back to the system
+    //Any secondary indexes are rebuilt once for the whole import, and the edges made during it are laid out in order
+    indexes_deferred = false;
+    rebuild_indexes();
+    rebuild_system_totals();
+    compact_edges();
+    //The catalogue now matches its files, so there is nothing to save, other than any changes recovered from its operation log
+    clear_changes();
+    recover_operation_log(operation_log_file_name(save_path));
+    //Makes sure that the files are unmapped and hence memory is released back to the system
     object_data.close();
     relationship_data.close();
 }
 
-void celestial_objects::catalogue::export_to_file()
+void celestial_objects::catalogue::parse_object_chunk(import_chunk& chunk)
 {
-    /* Allows a catalogue to be exported to a file. FAR simpler (and hence shorter) than trying to import a catalogue
-    as everything is cast to strings and saved to lines regardless of object. */
-    //Create file "<catalogue_name>.txt" using fstream
-    //Create file "<catalogue_name>_parents.txt" using fstream
-    //Need to pass fstream to export methods
-    std::fstream object_export;
-    std::fstream relationship_export;
-    if(!std::filesystem::exists(catalogue_name + ".dat")){
-        //Creates the data files if non-existent
-        std::cout << "File '" << catalogue_name << ".dat' does not exist. " << std::endl;
-        std::cout << "Creating file in local directory... " << std::endl;
-        object_export.open(catalogue_name + ".dat", std::ios::out | std::ios::trunc);
-        std::cout << "File created! " << std::endl;
-        if(!std::filesystem::exists(catalogue_name + "_relationships.dat")){
-            std::cout << "Creating relationship data file in local directory... " << std::endl;
-            relationship_export.open(catalogue_name + "_relationships.dat", std::ios::out | std::ios::trunc);
-            std::cout << "Relationship data file created!" << std::endl;
+    /* Parses every line in a chunk of an object file into objects. This runs on an import worker thread, so errors are
+    collected into the chunk's messages rather than written to the console, and the catalogue itself is not modified. */
+    std::string_view text{chunk.text};
+    std::string_view line;
+    while(next_line(text, line)){
+        if(line.empty()){
+            continue;
         }
-    } else{
-        //Just warns against files with pre-existing data and gives the option to prevent
-        std::cout << "WARNING: File '" << catalogue_name << ".dat' alrady exists in the local directory and contains data." << std::endl;
-        std::cout << "Would you like to overwrite '" << catalogue_name << ".dat'? [Y/N]   ";
-        char input;
-        bool valid_input{false};
-        while(!valid_input){
-            std::cin >> input;
-            std::cout << std::endl;
-            if(!(std::tolower(input) == 'y' || std::tolower(input) == 'n') || std::cin.fail()){
-                std::cout << "Invalid input. Please input either 'Y' or 'N'. [Y/N]   ";
-                std::cin.clear();
-                std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-            } else{
-                valid_input = true;
-            }
-        } if(std::tolower(input) == 'n'){
-            //Timestamps help fix the issue of creating a unique file name when exporting if an export is desired whilst not overwriting the base files.
-            //object_export.close();
-            //relationship_export.close();
-            std::time_t current{std::time(0)};
-            std::tm now{current};
-            std::stringstream timestamp;
-            timestamp << now.tm_yday << now.tm_mon << now.tm_year << "_" << now.tm_hour << now.tm_min << now.tm_sec;
-            object_export.open(catalogue_name + timestamp.str() +".dat", std::ios::out | std::ios::trunc);
-            std::cout << "Timestamped data file created!" << std::endl;
-            relationship_export.open(catalogue_name + timestamp.str() +"_relationships.dat", std::ios::out | std::ios::trunc);
-            std::cout << "Timestamped relationships data file created!" << std::endl;
-        } else{
-            //Reopens files in write-only, truncate mode if overwriting
-            //object_export.close();
-            object_export.open(catalogue_name + ".dat", std::ios::out | std::ios::trunc);
-            //relationship_export.close();
-            relationship_export.open(catalogue_name + "_relationships.dat", std::ios::out | std::ios::trunc);
+        try{
+            //Attemped conversion from the line into an object
+            //If this fails, it is clear that the .dat file loaded in was not configured for this program or there is an error in the file
+            //Where possible, data files should be generated by this program via the export_to_file() method and then read in as needed in subsequent sessions.
+            chunk.objects.push_back(parse_object_line(line, chunk.arena));
+        } catch(std::bad_alloc){
+            //Whilst unlikely on modern hardware, this will catch any cases where there is not enough memory left in RAM to assign an object.
+            chunk.messages += "Not enough memory available to allocate to object.\n";
+        } catch(std::invalid_argument const& exception){
+            //This should handle bad assignments due to incorrect data
+            //Theoretically, if this isn't thrown the constructor for each class SHOULD work.
+            chunk.messages += "ERROR: " + std::string(exception.what()) + "\n";
+        } catch(int i){
+            chunk.messages += "Unable to create object of unknown type  " + std::string(line.substr(0, line.find(':'))) + " .\n";
         }
     }
-
-    //Goes through all objects conatined in a catalogue and calls their export functions to write their data to the open files
-    for(catalogue_position = catalogue_objects.begin(); catalogue_position < catalogue_objects.end(); catalogue_position++){
-        std::shared_ptr<celestial_object> current_object_ptr{*catalogue_position};
-        current_object_ptr->export_to_file(object_export, relationship_export);
-    }
-    
-    //Closes the files
-    object_export.close();
-    relationship_export.close();
 }
 
-//CHANGE TO SHARED POINTER 
-void celestial_objects::catalogue::add_object(celestial_object* object)
+std::shared_ptr<celestial_objects::celestial_object> celestial_objects::catalogue::parse_object_line(std::string_view line,
+const std::shared_ptr<object_arena>& arena)
 {
-    std::shared_ptr<celestial_object> object_ptr{object};
-    catalogue_objects.push_back(object_ptr);
-    local_object_names.push_back(object_ptr.get()->get_name());
-    object_amount++;
+    /* Constructs an object from a single line of a catalogue .dat file. Fields are split as views into the line itself, so the
+    only allocations made are for the object's slab in the arena and its name. Throws std::invalid_argument for malformed data and an int for an
+    unknown object type, as the import loop expects.
+    The right ascension and declination follow the type-specific fields, and are optional so that files without positions can still be read. */
+    object_parameters parameters;
+    parse_object_fields(line, parameters);
+    return construct_object(parameters, arena);
 }
 
-void celestial_objects::catalogue::sort_catalogue(parameters& parameter)
+void celestial_objects::catalogue::parse_object_fields(std::string_view line, object_parameters& parameters)
 {
-    try 
-    {
-        switch (parameter)
-        {
-            case celestial_objects::parameters::Name:
-            {
-                std::sort(catalogue_objects.begin(), catalogue_objects.end(), 
-                [&](std::shared_ptr<celestial_object> const i, 
-                std::shared_ptr<celestial_object> const j)
-                {return celestial_objects::name_sort(i->get_name(), j->get_name());});
-            }
-            break;
-
-            case celestial_objects::parameters::Distance:
-            {
-                std::sort(catalogue_objects.begin(), catalogue_objects.end(), 
-                [&](std::shared_ptr<celestial_object> const i, 
-                std::shared_ptr<celestial_object> const j)
-                {return i->distance < j->distance;});
-            }
-            break;
-
-            case celestial_objects::parameters::Mass:
-            {
-                std::sort(catalogue_objects.begin(), catalogue_objects.end(), 
-                [&](std::shared_ptr<celestial_object> const i, 
-                std::shared_ptr<celestial_object> const j)
-                {return i->mass < j->mass;});
-            }
-            break;
-
-            case celestial_objects::parameters::Redshift:
-            {
-                std::sort(catalogue_objects.begin(), catalogue_objects.end(), 
-                [&](std::shared_ptr<celestial_object> const i, 
-                std::shared_ptr<celestial_object> const j)
-                {return i->redshift < j->redshift;});
-            }
-            break;
-
-            case celestial_objects::parameters::RotationalVelocity:
-            {
-                std::sort(catalogue_objects.begin(), catalogue_objects.end(), 
-                [&](std::shared_ptr<celestial_object> const i, 
-                std::shared_ptr<celestial_object> const j)
-                {return i->rotational_velocity < j->rotational_velocity;});
-            }
-            break;
-
-            case celestial_objects::parameters::MemberNumber:
-            {
-                std::sort(catalogue_objects.begin(), catalogue_objects.end(), 
-                [&](std::shared_ptr<celestial_object> const i, 
-                std::shared_ptr<celestial_object> const j)
-                {return i->member_number < j->member_number;});
-            }
-            break;
+    //Reads every field of an object line into a set of parameters, throwing std::invalid_argument for malformed data
+    std::array<std::string_view, max_line_fields> fields;
+    std::size_t field_number{split_fields(line, fields)};
+    if(field_number < 6){
+        throw std::invalid_argument("Object line '" + std::string(line) + "' has too few fields.");
+    }
 
-            default:
-            {
-                throw int{-1};
-            }
-            break;
+    //An unknown type throws the int the import loop expects, rather than becoming an out-of-range type that indexes past the type tables
+    int type_position{find_output_position(celestial_types_output, fields[0])};
+    if(type_position == int(celestial_types_output.size())){
+        throw(-1);
+    }
+    parameters.object_type = celestial_types(type_position);
+    parameters.name = std::string(fields[1]);
+    parameters.redshift = parse_double(fields[2]);
+    parameters.distance = parse_double(fields[3]);
+    parameters.mass = parse_double(fields[4]);
+    parameters.rotational_velocity = parse_double(fields[5]);
+    std::size_t position_field{6};
+
+    if(parameters.object_type == celestial_types::Galaxy){
+        //Handles a galaxy object due to its unique parameters
+        if(field_number < 8){
+            throw std::invalid_argument("Galaxy '" + parameters.name + "' is missing its galaxy parameters.");
         }
-
-        //Sorts the names afterwards
-        for(std::vector<std::shared_ptr<celestial_object>>::iterator i{catalogue_objects.begin()}; i < catalogue_objects.end(); i++){
-            local_object_names[int(i - catalogue_objects.begin())] = i->get()->get_name();
+        parameters.stellar_mass_fraction = parse_double(fields[6]);
+        parameters.hubble_type = hubble_types(parse_output_field(hubble_types_output, fields[7], "Hubble type"));
+        position_field = 8;
+
+    } else if(is_stellar_type(parameters.object_type)){
+        //Handles stellar objects and parses their extra paremeters
+        if(field_number < 11){
+            throw std::invalid_argument("Star '" + parameters.name + "' is missing its stellar parameters.");
+        }
+        parameters.star_type = stellar_types(parse_output_field(stellar_types_output, fields[6], "stellar type"));
+        parameters.stellar_digit = parse_int(fields[7]);
+        parameters.luminosity_id = luminosity_class(parse_output_field(luminosity_class_output, fields[8], "luminosity class"));
+        parameters.abs_magnitude = parse_double(fields[9]);
+        parameters.app_magnitude = parse_double(fields[10]);
+        position_field = 11;
+    }
+    if(field_number >= position_field + 2){
+        parameters.right_ascension = parse_double(fields[position_field]);
+        parameters.declination = parse_double(fields[position_field + 1]);
+        if(!valid_sky_position(parameters.right_ascension, parameters.declination)){
+            throw std::invalid_argument("Object '" + parameters.name + "' has a sky position out of range.");
         }
-    } catch(int e){
-        std::cout << "Cannot sort a full catalogue by special parameter. ";
     }
 }
 
-std::shared_ptr<celestial_objects::celestial_object> celestial_objects::catalogue::get_object(std::string name)
+void celestial_objects::catalogue::replay_object_deltas(std::string_view delta_text)
 {
-    std::vector<std::string>::iterator object_position{std::find_if(local_object_names.begin(),
-    local_object_names.end(), [&name](const std::string str){return str == name;})};
-    if(object_position >= local_object_names.end()){
-        std::cout << "Object not found, please enter another name. ";
-        throw(-1);
-    } else{
-        return catalogue_objects[int(object_position - local_object_names.begin())];
+    /* Applies the delta segments appended to an object file by save_changes(), in the order they were saved. A line naming an
+    object already in the catalogue replaces that object's data, keeping its position, id and relationships, and any other line
+    adds a new object. */
+    std::string_view line;
+    while(next_line(delta_text, line)){
+        if(line.empty() || line.front() == '#'){
+            continue;
+        }
+        apply_object_line(line);
     }
 }
 
-std::shared_ptr<celestial_objects::celestial_object> celestial_objects::catalogue::get_object(int index)
+void celestial_objects::catalogue::apply_object_line(std::string_view line)
 {
-    if(index < 0 || index >= catalogue_objects.size()){
-        std::cout << "Index out of range. " << std::endl;
-        throw(-1);
-    } else{
-        return catalogue_objects[index];
+    //Adds the object on a line of a .dat file, or updates the object of the same name if the catalogue already has one
+    try{
+        object_parameters parameters;
+        parse_object_fields(line, parameters);
+        int position{find_position(parameters.name)};
+        if(position == -1){
+            register_object(construct_object(parameters, object_storage));
+        } else if(type_column[position] != parameters.object_type){
+            throw std::invalid_argument("Object '" + parameters.name + "' cannot change its type.");
+        } else{
+            update_object(position, parameters);
+        }
+    } catch(std::bad_alloc){
+        std::cout << "Not enough memory available to allocate to object." << std::endl;
+    } catch(std::invalid_argument const& exception){
+        std::cout << "ERROR: " << exception.what() << std::endl;
+    } catch(int i){
+        std::cout << "Unable to create object of unknown type  " << line.substr(0, line.find(':')) << " ." << std::endl;
     }
 }
 
-std::vector<std::shared_ptr<celestial_objects::celestial_object>> celestial_objects::catalogue::subselect_catalogue(celestial_objects::celestial_types& type)
+void celestial_objects::catalogue::recover_operation_log(const std::string& log_path)
 {
-    std::vector<std::shared_ptr<celestial_objects::celestial_object>> subselection;
-    switch(type)
-    {
-        //This switch statement accounts for the derived classes, so that derived objects are captured when their base classes are requested
-        case celestial_objects::celestial_types::Star:
-        {
-            for(catalogue_position = catalogue_objects.begin(); catalogue_position < catalogue_objects.end(); catalogue_position++){
-                celestial_objects::celestial_types o_type{catalogue_position->get()->object_type};
-                if(o_type == celestial_objects::celestial_types::Star || o_type == celestial_objects::celestial_types::MainSequenceStar || 
-                o_type == celestial_objects::celestial_types::RedGiantStar || o_type == celestial_objects::celestial_types::StellarRemnant || 
-                o_type == celestial_objects::celestial_types::NeutronStar || o_type == celestial_objects::celestial_types::Pulsar){
-                    subselection.push_back(*catalogue_position);
-                }
-            }
-        }
-        break;
-
-        case celestial_objects::celestial_types::StellarRemnant:
-        {
-            for(catalogue_position = catalogue_objects.begin(); catalogue_position < catalogue_objects.end(); catalogue_position++){
-                celestial_objects::celestial_types o_type{catalogue_position->get()->object_type};
-                if(o_type == celestial_objects::celestial_types::StellarRemnant || o_type == celestial_objects::celestial_types::NeutronStar || 
-                o_type == celestial_objects::celestial_types::Pulsar){
-                    subselection.push_back(*catalogue_position);
-                }
+    /* Takes the operation log at log_path and replays the changes left in it by a session whose changes were never saved, so that
+    further changes are added after them. The replayed changes are marked as changed, so the next save writes them to the files
+    and starts a new log. The log is locked before it is read, so nothing is replayed from a log another catalogue is still using.
+    A log following an earlier save than the one the files were last written by holds only changes already in them, and is cleared. */
+    if(!open_operation_log(log_path)){
+        return;
+    }
+    mapped_file log_file;
+    std::size_t complete_size{0};
+    std::size_t log_size{0};
+    if(log_file.open(log_path)){
+        //A record cut short by a crash has no line ending, and is dropped
+        std::string_view log_text{log_file.contents()};
+        log_size = log_text.size();
+        complete_size = log_text.rfind('\n') + 1;
+        //Logs written before saves were numbered have no header, and are replayed in full
+        std::string_view header{log_text.substr(0, log_text.find('\n'))};
+        if(header.substr(0, 5) == "#log:" && complete_size > 0){
+            int log_sequence{save_sequence};
+            try{
+                log_sequence = parse_int(header.substr(5));
+            } catch(std::invalid_argument const& exception){
+                std::cout << "ERROR: " << exception.what() << std::endl;
             }
-        }
-        break;
-
-        case celestial_objects::celestial_types::NeutronStar:
-        {
-            for(catalogue_position = catalogue_objects.begin(); catalogue_position < catalogue_objects.end(); catalogue_position++){
-                celestial_objects::celestial_types o_type{catalogue_position->get()->object_type};
-                if(o_type == celestial_objects::celestial_types::NeutronStar || o_type == celestial_objects::celestial_types::Pulsar){
-                    subselection.push_back(*catalogue_position);
+            if(log_sequence < save_sequence){
+                log_file.close();
+                std::cout << "'" << log_path << "' only holds changes already saved, so has been cleared. " << std::endl;
+                if(!clear_operation_log()){
+                    std::cout << "WARNING: Could not clear '" << log_path << "', so saved changes may be recovered from it again. " << std::endl;
                 }
+                return;
             }
         }
-        break;
-
-        case celestial_objects::celestial_types::Planet:
-        {
-            for(catalogue_position = catalogue_objects.begin(); catalogue_position < catalogue_objects.end(); catalogue_position++){
-                celestial_objects::celestial_types o_type{catalogue_position->get()->object_type};
-                if(o_type == celestial_objects::celestial_types::Planet || o_type == celestial_objects::celestial_types::TerrestrialPlanet || 
-                o_type == celestial_objects::celestial_types::GaseousPlanet || o_type == celestial_objects::celestial_types::DwarfPlanet){
-                    subselection.push_back(*catalogue_position);
-                }
-            }
+        //The replayed changes are already in the log, so are not logged again
+        std::unique_ptr<operation_log> recovered_log{std::move(change_log)};
+        int record_number{replay_operation_log(log_text.substr(0, complete_size))};
+        change_log = std::move(recovered_log);
+        if(record_number > 0){
+            std::cout << record_number << " unsaved change(s) recovered from '" << log_path << "'. " << std::endl;
         }
-        break;
+    }
+    log_file.close();
+    if(complete_size == 0 && log_size > 0){
+        //Nothing but a cut short header was written, so the log is started again
+        clear_operation_log();
+    } else if(complete_size < log_size){
+        change_log->truncate(complete_size);
+    }
+}
 
-        case celestial_objects::celestial_types::Unassigned:
-        {
-            subselection = catalogue_objects;
+void celestial_objects::catalogue::restart_operation_log()
+{
+    /* Starts an empty operation log beside the files at save_path, once everything the current log held has been saved. A log
+    already at that path is cleared in place, so that its lock is never let go. */
+    std::string log_path{operation_log_file_name(save_path)};
+    if(change_log != nullptr && change_log->get_path() == log_path){
+        if(!clear_operation_log()){
+            std::cout << "WARNING: Could not clear '" << log_path << "', so saved changes may be recovered from it again. " << std::endl;
         }
-        break;
+        return;
+    }
+    if(change_log != nullptr){
+        //The old log is removed while it is still locked, so no other catalogue can have taken it
+        std::error_code error;
+        std::filesystem::remove(change_log->get_path(), error);
+        change_log.reset();
+    }
+    if(open_operation_log(log_path) && !clear_operation_log()){
+        std::cout << "WARNING: Could not clear '" << log_path << "', so saved changes may be recovered from it again. " << std::endl;
+    }
+}
 
-        //This accounts for any class without derivatives
-        default:
-        {
-            for(catalogue_position = catalogue_objects.begin(); catalogue_position < catalogue_objects.end(); catalogue_position++){
-                if(catalogue_position->get()->object_type == type){
-                    subselection.push_back(*catalogue_position);
-                }
-            }
+bool celestial_objects::catalogue::open_operation_log(const std::string& log_path)
+{
+    /* Starts logging changes to the operation log at log_path, appending to any records already in it. Returns false, leaving the
+    catalogue without a log, if the log cannot be opened or another catalogue is already logging to it. */
+    log_started = true;
+    change_log = std::make_unique<operation_log>();
+    if(change_log->open(log_path)){
+        //A new log starts with the number of the save it follows
+        std::error_code error;
+        if(std::filesystem::file_size(log_path, error) == 0 && !error){
+            export_buffer header;
+            header << "#log:" << save_sequence << '\n';
+            write_log_record(header.contents());
         }
-        break;
+        return true;
+    } else if(change_log->is_in_use()){
+        std::cout << "WARNING: '" << log_path << "' is in use by another catalogue, so changes to this one will not be recoverable after a crash. "
+        << std::endl;
+    } else{
+        std::cout << "WARNING: Could not open '" << log_path << "', so changes will not be recoverable after a crash. " << std::endl;
     }
-    
-    return subselection;
+    change_log.reset();
+    return false;
 }
 
-void celestial_objects::catalogue::generate_report()
+bool celestial_objects::catalogue::clear_operation_log()
 {
-    //Get number of objects
-    //Average distance and redshift
-    //Get number of each type
-    //
-    std::cout << "Catalogue: " << catalogue_name << std::endl;
-    std::cout << "Total number of objects: " << object_amount << std::endl;
-    std::cout << "Object information: " << std::endl;
-    std::cout << "----------------------------" << std::endl;
-    for(std::vector<std::shared_ptr<celestial_objects::celestial_object>>::iterator i{catalogue_objects.begin()}; i < catalogue_objects.end(); i++ ){
-        i->get()->get_properties();
-        std::cout << std::endl;
+    //Empties the operation log once everything in it has been saved, starting it again with the number of that save
+    if(!change_log->truncate(0)){
+        return false;
     }
+    export_buffer header;
+    header << "#log:" << save_sequence << '\n';
+    return change_log->append(header.contents());
 }
 
-std::string celestial_objects::catalogue::get_name()
+int celestial_objects::catalogue::replay_operation_log(std::string_view log_text)
 {
-    return catalogue_name;
+    /* Applies each record of an operation log in the order it was written, returning the number of records. Each record is a tag
+    followed by the same fields as the .dat files use: 'object' for an added or changed object line and 'member' for a relationship
+    line. The '#log' header line is not a record. */
+    int record_number{0};
+    std::string_view line;
+    std::array<std::string_view, max_line_fields> fields;
+    while(next_line(log_text, line)){
+        if(line.empty() || line.front() == '#'){
+            continue;
+        }
+        record_number++;
+        std::size_t tag_end{line.find(':')};
+        std::string_view tag{line.substr(0, tag_end)};
+        std::string_view record{tag_end == std::string_view::npos ? std::string_view{} : line.substr(tag_end + 1)};
+        try{
+            if(tag == "object"){
+                apply_object_line(record);
+            } else if(tag == "member"){
+                if(split_fields(record, fields) < 5){
+                    throw std::invalid_argument("Relationship record '" + std::string(record) + "' has too few fields.");
+                }
+                int parent_position{find_position(fields[0])};
+                int child_position{find_position(fields[1])};
+                if(parent_position == -1 || child_position == -1){
+                    throw std::invalid_argument("Relationship record '" + std::string(record) + "' names an object not in the catalogue.");
+                }
+                add_member(parent_position, child_position, parse_double(fields[2]), parse_double(fields[3]), parse_double(fields[4]));
+            } else{
+                throw std::invalid_argument("Operation log record '" + std::string(line) + "' is not recognised.");
+            }
+        } catch(std::invalid_argument const& exception){
+            std::cout << "ERROR: " << exception.what() << std::endl;
+        } catch(int e){
+            std::cout << "ERROR: Operation log record '" << line << "' could not be applied. " << std::endl;
+        }
+    }
+    return record_number;
 }
 
-bool celestial_objects::name_sort(std::string name_a, std::string name_b)
+void celestial_objects::catalogue::log_object(int position)
 {
-    for(int i{0}; i < name_a.size(); i++){
-        name_a[i] = std::tolower(name_a[i]);
-    } for(int i{0}; i < name_b.size(); i++){
-        name_b[i] = std::tolower(name_b[i]);
+    //Writes the current line of the object at a position to the operation log, as a record replayed by apply_object_line()
+    if(!logging_changes()){
+        return;
     }
-    return name_a < name_b;
+    export_buffer record;
+    //Relationships are logged separately as they are made
+    export_buffer unused_relationships;
+    record << "object:";
+    catalogue_objects[position]->export_to_file(record, unused_relationships);
+    write_log_record(record.contents());
 }
 
-bool celestial_objects::numerical_sort(int& a, int& b)
+void celestial_objects::catalogue::log_relationship(int edge)
 {
-    return a < b;
+    //Writes a relationship made by add_member() to the operation log
+    if(!logging_changes()){
+        return;
+    }
+    export_buffer record;
+    record << "member:";
+    export_relationship(record, edge);
+    write_log_record(record.contents());
 }
 
-bool celestial_objects::numerical_sort(double& a, double& b)
+bool celestial_objects::catalogue::logging_changes()
 {
-    return a < b;
+    /* True if the change being made should be written to the operation log. Changes made during an import are not logged, as the
+    import's own files hold them. A catalogue made from scratch has no files yet, so on its first change it opens its log beside
+    where export_to_file() will write them, keeping any records already there for whoever loads those files. */
+    if(indexes_deferred){
+        return false;
+    } else if(!log_started){
+        open_operation_log(operation_log_file_name(catalogue_name + ".dat"));
+    }
+    return change_log != nullptr;
 }
 
-bool celestial_objects::hubble_sort(celestial_objects::hubble_types& hubtype_a, celestial_objects::hubble_types& hubtype_b)
+void celestial_objects::catalogue::write_log_record(const std::string& record)
 {
-    int a{int(hubtype_a)};
-    int b{int(hubtype_b)};
-    return a < b;
+    //Commits a record to the operation log, warning that the change will not survive a crash if it could not be written
+    if(!change_log->append(record)){
+        std::cout << "ERROR: A change could not be written to '" << change_log->get_path() << "', so it will not be recoverable after a crash. "
+        << std::endl;
+    }
 }
 
-bool celestial_objects::stellar_sort(celestial_objects::stellar_types& steltype_a, celestial_objects::stellar_types& steltype_b)
+std::shared_ptr<celestial_objects::celestial_object> celestial_objects::catalogue::construct_object(object_parameters& parameters,
+const std::shared_ptr<object_arena>& arena)
 {
-    int a{int(steltype_a)};
-    int b{int(steltype_b)};
-    return a < b;
+    /* Builds an object of the given type directly from a full set of parameters, used by both the text and binary import paths.
+    The object is built in place within the given arena and the name is moved out of the parameters.
+    Throws an int if the type cannot be constructed, as the import loop expects. */
+    std::shared_ptr<celestial_object> object_ptr{nullptr};
+    std::string& object_name{parameters.name};
+    double& object_redshift{parameters.redshift};
+    double& object_distance{parameters.distance};
+    double& object_mass{parameters.mass};
+    double& object_omega{parameters.rotational_velocity};
+
+    if(parameters.object_type == celestial_types::Galaxy){
+        //There is only one type of galaxy object, so no switch statement is required for construction
+        object_ptr = make_arena_object<galaxy>(arena, std::move(object_name), object_redshift, object_distance, object_mass, object_omega,
+        parameters.stellar_mass_fraction, parameters.hubble_type);
+
+    } else if(is_stellar_type(parameters.object_type)){
+        //The default case does not throw an error, as we know from the else if above that the type must be within those checked by is_stellar_type()
+        stellar_types stel_type{parameters.star_type};
+        int stel_digit{parameters.stellar_digit};
+        luminosity_class lum_no{parameters.luminosity_id};
+        double absolute_lum{parameters.abs_magnitude};
+        double apparent_lum{parameters.app_magnitude};
+
+        //Whilst extensive, this switch handles the construction of individual objects via identification of object type
+        switch(parameters.object_type)
+        {
+            //Handles all stellar objects as they have more parameters due to being luminous
+            case celestial_types::RedGiantStar:
+            {
+                object_ptr = make_arena_object<red_giant_star>(arena, std::move(object_name), object_redshift, object_distance, object_mass, object_omega, stel_type,
+                stel_digit, lum_no, absolute_lum, apparent_lum);
+            }
+            break;
+
+            case celestial_types::MainSequenceStar:
+            {
+                object_ptr = make_arena_object<main_sequence_star>(arena, std::move(object_name), object_redshift, object_distance, object_mass, object_omega, stel_type,
+                stel_digit, lum_no, absolute_lum, apparent_lum);
+            }
+            break;
+
+            case celestial_types::NeutronStar:
+            {
+                object_ptr = make_arena_object<neutron_star>(arena, std::move(object_name), object_redshift, object_distance, object_mass, object_omega, stel_type,
+                stel_digit, lum_no, absolute_lum, apparent_lum);
+            }
+            break;
+
+            case celestial_types::Pulsar:
+            {
+                object_ptr = make_arena_object<pulsar>(arena, std::move(object_name), object_redshift, object_distance, object_mass, object_omega, stel_type,
+                stel_digit, lum_no, absolute_lum, apparent_lum);
+            }
+            break;
+
+            case celestial_types::StellarRemnant:
+            {
+                object_ptr = make_arena_object<stellar_remnant>(arena, std::move(object_name), object_redshift, object_distance, object_mass, object_omega, stel_type,
+                stel_digit, lum_no, absolute_lum, apparent_lum);
+            }
+            break;
+
+            case celestial_types::Supernova:
+            {
+                object_ptr = make_arena_object<supernova>(arena, std::move(object_name), object_redshift, object_distance, object_mass, object_omega, stel_type,
+                stel_digit, lum_no, absolute_lum, apparent_lum);
+            }
+            break;
+
+            default:
+            {
+                object_ptr = make_arena_object<star>(arena, std::move(object_name), object_redshift, object_distance, object_mass, object_omega, stel_type,
+                stel_digit, lum_no, absolute_lum, apparent_lum);
+            }
+            break;                                
+        }
+    } else{
+        //Handles all other derived classes not derived from the star class
+        switch (parameters.object_type)
+        {
+            case celestial_types::Asteroid:
+            {
+                object_ptr = make_arena_object<asteroid>(arena, std::move(object_name), object_redshift, object_distance, object_mass, object_omega);
+            }
+            break;
+    
+            case celestial_types::BlackHole:
+            {
+                object_ptr = make_arena_object<black_hole>(arena, std::move(object_name), object_redshift, object_distance, object_mass, object_omega);
+            }
+            break;
+    
+            case celestial_types::Comet:
+            {
+                object_ptr = make_arena_object<comet>(arena, std::move(object_name), object_redshift, object_distance, object_mass, object_omega);
+            }
+            break;
+    
+            case celestial_types::DwarfPlanet:
+            {
+                object_ptr = make_arena_object<dwarf_planet>(arena, std::move(object_name), object_redshift, object_distance, object_mass, object_omega);
+            }
+            break;
+    
+            case celestial_types::GaseousPlanet:
+            {
+                object_ptr = make_arena_object<gaseous_planet>(arena, std::move(object_name), object_redshift, object_distance, object_mass, object_omega);
+            }
+            break;
+    
+            case celestial_types::Moon:
+            {
+                object_ptr = make_arena_object<moon>(arena, std::move(object_name), object_redshift, object_distance, object_mass, object_omega);
+            }
+            break;
+    
+            case celestial_types::Planet:
+            {
+                object_ptr = make_arena_object<planet>(arena, std::move(object_name), object_redshift, object_distance, object_mass, object_omega);
+            }
+            break;
+    
+            case celestial_types::TerrestrialPlanet:
+            {
+                object_ptr = make_arena_object<terrestrial_planet>(arena, std::move(object_name), object_redshift, object_distance, object_mass, object_omega);
+            }
+            break;
+    
+            default:
+            {
+                //If all else fails and an object cannot be created, an error will be thrown by default.
+                throw int{-1};
+            }
+            break;
+        }
+    }
+    object_ptr->right_ascension = parameters.right_ascension;
+    object_ptr->declination = parameters.declination;
+    return object_ptr;
+}
+
+void celestial_objects::catalogue::export_to_file()
+{
+    /* Allows a catalogue to be exported to a file. FAR simpler (and hence shorter) than trying to import a catalogue
+    as everything is cast to strings and saved to lines regardless of object. */
+    //Create file "<catalogue_name>.txt" using fstream
+    //Create file "<catalogue_name>_parents.txt" using fstream
+    //Need to pass fstream to export methods
+    std::fstream object_export;
+    std::fstream relationship_export;
+    std::string object_file_name{catalogue_name + ".dat"};
+    if(!std::filesystem::exists(catalogue_name + ".dat")){
+        //Creates the data files if non-existent
+        std::cout << "File '" << catalogue_name << ".dat' does not exist. " << std::endl;
+        std::cout << "Creating file in local directory... " << std::endl;
+        object_export.open(catalogue_name + ".dat", std::ios::out | std::ios::trunc);
+        std::cout << "File created! " << std::endl;
+        if(!std::filesystem::exists(catalogue_name + "_relationships.dat")){
+            std::cout << "Creating relationship data file in local directory... " << std::endl;
+        }
+        //Any relationship file left without its object file is replaced, so that it cannot be read back alongside the new objects
+        relationship_export.open(catalogue_name + "_relationships.dat", std::ios::out | std::ios::trunc);
+    } else{
+        //Just warns against files with pre-existing data and gives the option to prevent
+        std::cout << "WARNING: File '" << catalogue_name << ".dat' alrady exists in the local directory and contains data." << std::endl;
+        std::cout << "Would you like to overwrite '" << catalogue_name << ".dat'? [Y/N]   ";
+        char input;
+        bool valid_input{false};
+        while(!valid_input){
+            std::cin >> input;
+            std::cout << std::endl;
+            if(!(std::tolower(input) == 'y' || std::tolower(input) == 'n') || std::cin.fail()){
+                std::cout << "Invalid input. Please input either 'Y' or 'N'. [Y/N]   ";
+                std::cin.clear();
+                std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+            } else{
+                valid_input = true;
+            }
+        } if(std::tolower(input) == 'n'){
+            //Timestamps help fix the issue of creating a unique file name when exporting if an export is desired whilst not overwriting the base files.
+            //object_export.close();
+            //relationship_export.close();
+            std::string timestamp{timestamp_string()};
+            object_file_name = catalogue_name + timestamp + ".dat";
+            object_export.open(catalogue_name + timestamp +".dat", std::ios::out | std::ios::trunc);
+            std::cout << "Timestamped data file created!" << std::endl;
+            relationship_export.open(catalogue_name + timestamp +"_relationships.dat", std::ios::out | std::ios::trunc);
+            std::cout << "Timestamped relationships data file created!" << std::endl;
+        } else{
+            //Reopens files in write-only, truncate mode if overwriting
+            //object_export.close();
+            object_export.open(catalogue_name + ".dat", std::ios::out | std::ios::trunc);
+            //relationship_export.close();
+            relationship_export.open(catalogue_name + "_relationships.dat", std::ios::out | std::ios::trunc);
+        }
+    }
+
+    //Goes through all objects conatined in a catalogue and calls their export functions to format their data
+    //Each round, the next few slices of the catalogue are formatted into separate buffers on separate threads, then the buffers
+    //are written out in catalogue order, so the files are identical to formatting every object in turn on one thread
+    int worker_number{choose_worker_count(catalogue_objects.size(), export_objects_per_worker)};
+    std::vector<export_buffer> object_buffers(worker_number);
+    std::vector<export_buffer> relationship_buffers(worker_number);
+    auto format_slice = [&](int worker, std::size_t begin, std::size_t end)
+    {
+        for(std::size_t i{begin}; i < end; i++){
+            catalogue_objects[i]->export_to_file(object_buffers[worker], relationship_buffers[worker]);
+            export_relationships(relationship_buffers[worker], int(i));
+        }
+    };
+    std::size_t round_size{std::size_t(worker_number) * export_objects_per_worker};
+    for(std::size_t round_begin{0}; round_begin < catalogue_objects.size(); round_begin += round_size){
+        std::size_t round_end{std::min(catalogue_objects.size(), round_begin + round_size)};
+        std::vector<std::thread> workers;
+        for(int i{1}; i < worker_number; i++){
+            std::size_t slice_begin{std::min(round_end, round_begin + std::size_t(i) * export_objects_per_worker)};
+            workers.emplace_back(format_slice, i, slice_begin, std::min(round_end, slice_begin + export_objects_per_worker));
+        }
+        format_slice(0, round_begin, std::min(round_end, round_begin + export_objects_per_worker));
+        for(std::thread& worker : workers){
+            worker.join();
+        }
+        for(int i{0}; i < worker_number; i++){
+            object_buffers[i].write_to(object_export);
+            relationship_buffers[i].write_to(relationship_export);
+        }
+    }
+    //The files end with an empty delta numbered as the next save, so that a log left beside them from before it is not replayed
+    int delta_number{save_sequence + 1};
+    object_export << "#delta:" << delta_number << '\n';
+    if(!object_export.good() || !relationship_export.good()){
+        std::cout << "ERROR: The catalogue could not be completely written to disk. " << std::endl;
+    } else{
+        //Later changes can be saved by appending them to the files just written
+        save_path = object_file_name;
+        save_sequence = delta_number;
+        clear_changes();
+        restart_operation_log();
+    }
+
+    //Closes the files
+    object_export.close();
+    relationship_export.close();
+}
+
+bool celestial_objects::catalogue::import_from_binary(const std::string& file_name)
+{
+    /* Loads a catalogue written by export_to_binary(). Columns are copied straight out of the mapped file, so no numbers need
+    to be parsed. Returns false without modifying the catalogue if the file cannot be opened or is not a valid binary catalogue. */
+    mapped_file binary_data;
+    if(!binary_data.open(file_name)){
+        std::cout << "File or file directory '" << file_name << "' does not exist." << std::endl;
+        std::cout << std::endl;
+        return false;
+    }
+    std::string_view contents{binary_data.contents()};
+    binary_catalogue_header header;
+    if(contents.size() < sizeof(header)){
+        std::cout << "File '" << file_name << "' is too small to be a binary catalogue." << std::endl;
+        return false;
+    }
+    std::memcpy(&header, contents.data(), sizeof(header));
+    if(std::memcmp(header.magic, binary_catalogue_magic, sizeof(header.magic)) != 0){
+        std::cout << "File '" << file_name << "' is not a binary catalogue." << std::endl;
+        return false;
+    } else if(header.version < 1 || header.version > binary_catalogue_version){
+        std::cout << "Binary catalogue version " << header.version << " is not supported." << std::endl;
+        return false;
+    } else if(header.byte_order != binary_byte_order_mark){
+        std::cout << "Binary catalogue was written on a machine with a different byte order." << std::endl;
+        return false;
+    }
+
+    //Each column is read in turn from just after the header, skipping the padding that keeps columns 8-byte aligned
+    std::size_t n{std::size_t(header.object_count)};
+    std::size_t edge_number{std::size_t(header.edge_count)};
+    std::size_t read_position{sizeof(header)};
+    //The counts are checked against the size of the file before anything is allocated from them, so that a corrupt count is
+    //reported as such rather than attempting a huge allocation. Padding is left out, so this is only a lower bound on the size needed
+    std::size_t available_bytes{contents.size() - sizeof(header)};
+    std::size_t object_bytes{std::size_t(header.version >= 2 ? 88 : 72)};
+    std::size_t edge_bytes{2 * sizeof(std::int32_t) + 3 * sizeof(double)};
+    if(header.object_count > available_bytes / object_bytes || header.edge_count > available_bytes / edge_bytes
+    || header.name_heap_size > available_bytes
+    || n * object_bytes + sizeof(std::uint64_t) + edge_number * edge_bytes + std::size_t(header.name_heap_size) > available_bytes){
+        std::cout << "Binary catalogue '" << file_name << "' is truncated or corrupt." << std::endl;
+        return false;
+    }
+    bool truncated{false};
+    auto read_column = [&](void* destination, std::size_t bytes)
+    {
+        std::size_t padded_bytes{(bytes + 7) & ~std::size_t(7)};
+        if(truncated || padded_bytes > contents.size() - read_position){
+            truncated = true;
+        } else{
+            std::memcpy(destination, contents.data() + read_position, bytes);
+            read_position += padded_bytes;
+        }
+    };
+    std::vector<std::uint8_t> type_column(n);
+    std::vector<double> redshift_column(n);
+    std::vector<double> distance_column(n);
+    std::vector<double> mass_column(n);
+    std::vector<double> rotational_velocity_column(n);
+    std::vector<double> mass_fraction_column(n);
+    std::vector<std::uint8_t> hubble_type_column(n);
+    std::vector<std::uint8_t> stellar_type_column(n);
+    std::vector<std::int32_t> stellar_digit_column(n);
+    std::vector<std::uint8_t> luminosity_column(n);
+    std::vector<double> abs_magnitude_column(n);
+    std::vector<double> app_magnitude_column(n);
+    std::vector<double> right_ascension_column(n, 0);
+    std::vector<double> declination_column(n, 0);
+    std::vector<std::uint64_t> name_offsets(n + 1);
+    std::string name_heap(std::size_t(header.name_heap_size), '\0');
+    std::vector<std::int32_t> edge_parents(edge_number);
+    std::vector<std::int32_t> edge_children(edge_number);
+    std::vector<double> edge_distances(edge_number);
+    std::vector<double> edge_tilts(edge_number);
+    std::vector<double> edge_eccentricities(edge_number);
+    read_column(type_column.data(), n);
+    read_column(redshift_column.data(), n * sizeof(double));
+    read_column(distance_column.data(), n * sizeof(double));
+    read_column(mass_column.data(), n * sizeof(double));
+    read_column(rotational_velocity_column.data(), n * sizeof(double));
+    read_column(mass_fraction_column.data(), n * sizeof(double));
+    read_column(hubble_type_column.data(), n);
+    read_column(stellar_type_column.data(), n);
+    read_column(stellar_digit_column.data(), n * sizeof(std::int32_t));
+    read_column(luminosity_column.data(), n);
+    read_column(abs_magnitude_column.data(), n * sizeof(double));
+    read_column(app_magnitude_column.data(), n * sizeof(double));
+    if(header.version >= 2){
+        //Version 1 files have no sky positions, so their objects are left at the origin
+        read_column(right_ascension_column.data(), n * sizeof(double));
+        read_column(declination_column.data(), n * sizeof(double));
+    }
+    read_column(name_offsets.data(), (n + 1) * sizeof(std::uint64_t));
+    read_column(name_heap.data(), name_heap.size());
+    read_column(edge_parents.data(), edge_number * sizeof(std::int32_t));
+    read_column(edge_children.data(), edge_number * sizeof(std::int32_t));
+    read_column(edge_distances.data(), edge_number * sizeof(double));
+    read_column(edge_tilts.data(), edge_number * sizeof(double));
+    read_column(edge_eccentricities.data(), edge_number * sizeof(double));
+    //Every name offset must lie within the name heap, as rows are only checked against their neighbours' offsets below
+    if(truncated || std::any_of(name_offsets.begin(), name_offsets.end(), [&name_heap](std::uint64_t offset){return offset > name_heap.size();})){
+        std::cout << "Binary catalogue '" << file_name << "' is truncated or corrupt." << std::endl;
+        return false;
+    }
+
+    std::size_t catalogue_name_begin{file_name.find_last_of("/") + 1};
+    catalogue_name = file_name.substr(catalogue_name_begin, file_name.length() - 5 - catalogue_name_begin);
+    std::cout << "File found successfully!" << std::endl;
+
+    //Rows which cannot be constructed are skipped, so the edge table is resolved through the position each row ended up in
+    std::vector<int> row_positions(n, -1);
+    reserve_objects(n);
+    indexes_deferred = true;
+    object_parameters parameters;
+    for(std::size_t i{0}; i < n; i++){
+        if(name_offsets[i] > name_offsets[i + 1]){
+            std::cout << "ERROR: Object " << i << " has an invalid name." << std::endl;
+            continue;
+        }
+        parameters.name.assign(name_heap, std::size_t(name_offsets[i]), std::size_t(name_offsets[i + 1] - name_offsets[i]));
+        //The enum columns are only cast once they are known to be in range, as they are used to index the output vectors
+        if(type_column[i] >= celestial_types_output.size() || hubble_type_column[i] >= hubble_types_output.size()
+        || stellar_type_column[i] >= stellar_types_output.size() || luminosity_column[i] >= luminosity_class_output.size()){
+            std::cout << "ERROR: Object '" << parameters.name << "' has an invalid type or classification." << std::endl;
+            continue;
+        }
+        parameters.object_type = celestial_types(type_column[i]);
+        parameters.redshift = redshift_column[i];
+        parameters.distance = distance_column[i];
+        parameters.mass = mass_column[i];
+        parameters.rotational_velocity = rotational_velocity_column[i];
+        parameters.stellar_mass_fraction = mass_fraction_column[i];
+        parameters.hubble_type = hubble_types(hubble_type_column[i]);
+        parameters.star_type = stellar_types(stellar_type_column[i]);
+        parameters.stellar_digit = stellar_digit_column[i];
+        parameters.luminosity_id = luminosity_class(luminosity_column[i]);
+        parameters.abs_magnitude = abs_magnitude_column[i];
+        parameters.app_magnitude = app_magnitude_column[i];
+        parameters.right_ascension = right_ascension_column[i];
+        parameters.declination = declination_column[i];
+        if(!valid_sky_position(parameters.right_ascension, parameters.declination)){
+            std::cout << "ERROR: Object '" << parameters.name << "' has a sky position out of range." << std::endl;
+            continue;
+        }
+        try{
+            std::shared_ptr<celestial_object> object_ptr{construct_object(parameters, object_storage)};
+            row_positions[i] = object_amount;
+            register_object(std::move(object_ptr));
+        } catch(std::bad_alloc){
+            std::cout << "Not enough memory available to allocate to object." << std::endl;
+        } catch(int e){
+            std::cout << "Unable to create object '" << parameters.name << "' of unknown type." << std::endl;
+        }
+    }
+
+    int unresolved_edges{0};
+    std::vector<object_relationship> relationships;
+    relationships.reserve(edge_number);
+    for(std::size_t i{0}; i < edge_number; i++){
+        std::int32_t parent_row{edge_parents[i]};
+        std::int32_t child_row{edge_children[i]};
+        if(parent_row < 0 || child_row < 0 || std::size_t(parent_row) >= n || std::size_t(child_row) >= n
+        || row_positions[parent_row] == -1 || row_positions[child_row] == -1){
+            unresolved_edges++;
+        } else{
+            relationships.push_back(object_relationship{row_positions[parent_row], row_positions[child_row], edge_distances[i], edge_tilts[i],
+            edge_eccentricities[i]});
+        }
+    }
+    report_link_errors(link_all(relationships));
+    if(unresolved_edges > 0){
+        std::cout << unresolved_edges << " relationship(s) refer to objects missing from the catalogue and have not been created. " << std::endl;
+    }
+    indexes_deferred = false;
+    rebuild_indexes();
+    rebuild_system_totals();
+    //Binary catalogues cannot have changes appended, so the first save of changes will export the whole catalogue
+    save_path = "";
+    save_sequence = int(header.save_sequence);
+    clear_changes();
+    //Changes are still logged beside the .ccat file, and any left there by a session that was never saved are recovered
+    recover_operation_log(operation_log_file_name(file_name));
+    return true;
+}
+
+void celestial_objects::catalogue::export_to_binary()
+{
+    /* Writes the catalogue to '<catalogue_name>.ccat' in the binary columnar format described by binary_catalogue_header.
+    Holds the same information as the .dat pair written by export_to_file(), including relationships. */
+    std::string file_name{catalogue_name + ".ccat"};
+    if(std::filesystem::exists(file_name)){
+        std::cout << "WARNING: File '" << file_name << "' already exists in the local directory and contains data." << std::endl;
+        std::cout << "Would you like to overwrite '" << file_name << "'? [Y/N]   ";
+        char input;
+        bool valid_input{false};
+        while(!valid_input){
+            std::cin >> input;
+            std::cout << std::endl;
+            if(!(std::tolower(input) == 'y' || std::tolower(input) == 'n') || std::cin.fail()){
+                std::cout << "Invalid input. Please input either 'Y' or 'N'. [Y/N]   ";
+                std::cin.clear();
+                std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+            } else{
+                valid_input = true;
+            }
+        } if(std::tolower(input) == 'n'){
+            file_name = catalogue_name + timestamp_string() + ".ccat";
+        }
+    }
+
+    //Gathers each column from the objects, leaving zeroes in the type-specific columns where they do not apply
+    std::size_t n{catalogue_objects.size()};
+    std::vector<std::uint8_t> type_column(n);
+    std::vector<double> redshift_column(n);
+    std::vector<double> distance_column(n);
+    std::vector<double> mass_column(n);
+    std::vector<double> rotational_velocity_column(n);
+    std::vector<double> mass_fraction_column(n, 0);
+    std::vector<std::uint8_t> hubble_type_column(n, 0);
+    std::vector<std::uint8_t> stellar_type_column(n, 0);
+    std::vector<std::int32_t> stellar_digit_column(n, 0);
+    std::vector<std::uint8_t> luminosity_column(n, 0);
+    std::vector<double> abs_magnitude_column(n, 0);
+    std::vector<double> app_magnitude_column(n, 0);
+    std::vector<double> right_ascension_column(n);
+    std::vector<double> declination_column(n);
+    std::vector<std::uint64_t> name_offsets(n + 1, 0);
+    std::string name_heap;
+    std::vector<std::int32_t> edge_parents;
+    std::vector<std::int32_t> edge_children;
+    std::vector<double> edge_distances;
+    std::vector<double> edge_tilts;
+    std::vector<double> edge_eccentricities;
+    for(std::size_t i{0}; i < n; i++){
+        celestial_object* object{catalogue_objects[i].get()};
+        type_column[i] = std::uint8_t(object->object_type);
+        redshift_column[i] = object->redshift;
+        distance_column[i] = object->distance;
+        mass_column[i] = object->mass;
+        rotational_velocity_column[i] = object->rotational_velocity;
+        right_ascension_column[i] = object->right_ascension;
+        declination_column[i] = object->declination;
+        if(object->object_type == celestial_types::Galaxy){
+            galaxy* galaxy_object{static_cast<galaxy*>(object)};
+            mass_fraction_column[i] = galaxy_object->stellar_mass_fraction;
+            hubble_type_column[i] = std::uint8_t(galaxy_object->hubble_type);
+        } else if(is_stellar_type(object->object_type)){
+            star* star_object{static_cast<star*>(object)};
+            stellar_type_column[i] = std::uint8_t(star_object->star_type);
+            stellar_digit_column[i] = std::int32_t(star_object->stellar_digit);
+            luminosity_column[i] = std::uint8_t(star_object->luminosity_id);
+            abs_magnitude_column[i] = star_object->abs_magnitude;
+            app_magnitude_column[i] = star_object->app_magnitude;
+        }
+        name_heap += object_names.get_name(name_id_column[i]);
+        name_offsets[i + 1] = name_heap.size();
+
+        //Row numbers are the object positions within the catalogue, so children are given by the position of their ids
+        for(int edge{first_edges[object_id_column[i]]}; edge != -1; edge = next_edges[edge]){
+            edge_parents.push_back(std::int32_t(i));
+            edge_children.push_back(std::int32_t(object_positions[edge_child_ids[edge]]));
+            edge_distances.push_back(edge_orbit_distances[edge]);
+            edge_tilts.push_back(edge_orbit_tilts[edge]);
+            edge_eccentricities.push_back(edge_orbit_eccentricities[edge]);
+        }
+    }
+
+    binary_catalogue_header header;
+    std::memcpy(header.magic, binary_catalogue_magic, sizeof(header.magic));
+    header.version = binary_catalogue_version;
+    header.byte_order = binary_byte_order_mark;
+    header.save_sequence = std::uint32_t(save_sequence + 1);
+    header.object_count = n;
+    header.name_heap_size = name_heap.size();
+    header.edge_count = edge_parents.size();
+
+    std::ofstream binary_export(file_name, std::ios::out | std::ios::binary | std::ios::trunc);
+    if(!binary_export.good()){
+        std::cout << "Unable to create file '" << file_name << "'. " << std::endl;
+        return;
+    }
+    std::size_t edge_number{edge_parents.size()};
+    write_binary_column(binary_export, &header, sizeof(header));
+    write_binary_column(binary_export, type_column.data(), n);
+    write_binary_column(binary_export, redshift_column.data(), n * sizeof(double));
+    write_binary_column(binary_export, distance_column.data(), n * sizeof(double));
+    write_binary_column(binary_export, mass_column.data(), n * sizeof(double));
+    write_binary_column(binary_export, rotational_velocity_column.data(), n * sizeof(double));
+    write_binary_column(binary_export, mass_fraction_column.data(), n * sizeof(double));
+    write_binary_column(binary_export, hubble_type_column.data(), n);
+    write_binary_column(binary_export, stellar_type_column.data(), n);
+    write_binary_column(binary_export, stellar_digit_column.data(), n * sizeof(std::int32_t));
+    write_binary_column(binary_export, luminosity_column.data(), n);
+    write_binary_column(binary_export, abs_magnitude_column.data(), n * sizeof(double));
+    write_binary_column(binary_export, app_magnitude_column.data(), n * sizeof(double));
+    write_binary_column(binary_export, right_ascension_column.data(), n * sizeof(double));
+    write_binary_column(binary_export, declination_column.data(), n * sizeof(double));
+    write_binary_column(binary_export, name_offsets.data(), (n + 1) * sizeof(std::uint64_t));
+    write_binary_column(binary_export, name_heap.data(), name_heap.size());
+    write_binary_column(binary_export, edge_parents.data(), edge_number * sizeof(std::int32_t));
+    write_binary_column(binary_export, edge_children.data(), edge_number * sizeof(std::int32_t));
+    write_binary_column(binary_export, edge_distances.data(), edge_number * sizeof(double));
+    write_binary_column(binary_export, edge_tilts.data(), edge_number * sizeof(double));
+    write_binary_column(binary_export, edge_eccentricities.data(), edge_number * sizeof(double));
+    //Closing flushes the last of the file, so the stream is checked afterwards to catch a failure in any of the writes
+    binary_export.close();
+    if(binary_export.fail()){
+        std::cout << "ERROR: The binary catalogue '" << file_name << "' could not be completely written to disk. " << std::endl;
+        return;
+    }
+    std::cout << "Binary catalogue '" << file_name << "' written. " << std::endl;
+    //A log kept beside the file just written holds no change that the file does not, so would only be replayed twice
+    save_sequence++;
+    if(change_log != nullptr && change_log->get_path() == operation_log_file_name(file_name) && !clear_operation_log()){
+        std::cout << "WARNING: Could not clear '" << change_log->get_path() << "', so saved changes may be recovered from it again. " << std::endl;
+    }
+}
+
+//CHANGE TO SHARED POINTER 
+void celestial_objects::catalogue::add_object(celestial_object* object)
+{
+    register_object(std::shared_ptr<celestial_object>{object});
+}
+
+void celestial_objects::catalogue::register_object(std::shared_ptr<celestial_object> object_ptr)
+{
+    /* Appends an object to the catalogue, keeping the name list, name index and every column in step with catalogue_objects.
+    All paths which add objects go through here. */
+    int name_id{object_names.intern(object_ptr->name)};
+    name_id_column.push_back(name_id);
+    //Objects are never removed, so the number of objects added so far is a new unique id
+    object_id_column.push_back(object_amount);
+    object_positions.push_back(object_amount);
+    if(name_id == int(name_positions.size())){
+        name_positions.push_back(object_amount);
+    } else{
+        //A repeated name refers to the newest object with that name, as the old name index did
+        name_positions[name_id] = object_amount;
+    }
+    redshift_column.push_back(object_ptr->redshift);
+    distance_column.push_back(object_ptr->distance);
+    mass_column.push_back(object_ptr->mass);
+    rotational_velocity_column.push_back(object_ptr->rotational_velocity);
+    right_ascension_column.push_back(object_ptr->right_ascension);
+    declination_column.push_back(object_ptr->declination);
+    sky_pixel_column.push_back(sky_pixel(object_ptr->right_ascension, object_ptr->declination, sky_index_level));
+    type_column.push_back(object_ptr->object_type);
+    //Type-specific columns hold Unassigned for objects they do not apply to
+    hubble_types hubble_type{hubble_types::Unassigned};
+    stellar_types star_type{stellar_types::Unassigned};
+    if(object_ptr->object_type == celestial_types::Galaxy){
+        hubble_type = static_cast<galaxy*>(object_ptr.get())->hubble_type;
+    } else if(is_stellar_type(object_ptr->object_type)){
+        star_type = static_cast<star*>(object_ptr.get())->star_type;
+    }
+    hubble_type_column.push_back(hubble_type);
+    stellar_type_column.push_back(star_type);
+    //Members made on the object itself are not part of the catalogue's hierarchy store, so every object joins with no members here
+    member_number_column.push_back(0);
+    parent_ids.push_back(-1);
+    parent_edges.push_back(-1);
+    first_edges.push_back(-1);
+    last_edges.push_back(-1);
+    //Each new object starts as the only member of its own tree
+    hierarchy_links.push_back(object_amount);
+    hierarchy_sizes.push_back(1);
+    hierarchy_roots.push_back(object_amount);
+    depth_offsets.push_back(0);
+    system_masses.push_back(object_ptr->mass);
+    system_sizes.push_back(0);
+    system_type_counts.resize(system_type_counts.size() + celestial_type_number, 0);
+    system_orbit_distances.push_back(0);
+    catalogue_objects.push_back(std::move(object_ptr));
+    object_amount++;
+    neighbour_tree_stale = true;
+    mark_changed(object_amount - 1);
+    log_object(object_amount - 1);
+    if(!indexes_deferred){
+        for(int i{0}; i < parameter_number; i++){
+            if(indexed_parameters[i]){
+                insert_into_index(parameters(i), object_amount - 1);
+            }
+        }
+        insert_into_sky_index(object_amount - 1);
+    }
+}
+
+void celestial_objects::catalogue::reserve_objects(std::size_t added_number)
+{
+    //Sizes the object list, name table and columns once before a bulk import, rather than letting each grow repeatedly
+    std::size_t total_number{catalogue_objects.size() + added_number};
+    catalogue_objects.reserve(total_number);
+    object_names.reserve(total_number);
+    name_id_column.reserve(total_number);
+    name_positions.reserve(total_number);
+    object_id_column.reserve(total_number);
+    object_positions.reserve(total_number);
+    redshift_column.reserve(total_number);
+    distance_column.reserve(total_number);
+    mass_column.reserve(total_number);
+    rotational_velocity_column.reserve(total_number);
+    right_ascension_column.reserve(total_number);
+    declination_column.reserve(total_number);
+    sky_pixel_column.reserve(total_number);
+    type_column.reserve(total_number);
+    hubble_type_column.reserve(total_number);
+    stellar_type_column.reserve(total_number);
+    member_number_column.reserve(total_number);
+    parent_ids.reserve(total_number);
+    parent_edges.reserve(total_number);
+    first_edges.reserve(total_number);
+    last_edges.reserve(total_number);
+    hierarchy_links.reserve(total_number);
+    hierarchy_sizes.reserve(total_number);
+    hierarchy_roots.reserve(total_number);
+    depth_offsets.reserve(total_number);
+    system_masses.reserve(total_number);
+    system_sizes.reserve(total_number);
+    system_type_counts.reserve(total_number*celestial_type_number);
+    system_orbit_distances.reserve(total_number);
+}
+
+void celestial_objects::catalogue::compact_edges()
+{
+    /* Renumbers the edges so that each object's edges are contiguous and in order, with the objects in catalogue order, so that
+    walking the hierarchy reads the edge arrays from start to end. Run after bulk imports, whose relationships arrive in any order. */
+    std::vector<int> order;
+    order.reserve(edge_child_ids.size());
+    std::vector<int> edge_counts(object_amount, 0);
+    for(int position{0}; position < object_amount; position++){
+        for(int edge{first_edges[object_id_column[position]]}; edge != -1; edge = next_edges[edge]){
+            order.push_back(edge);
+            edge_counts[position]++;
+        }
+    }
+    permute_column(edge_child_ids, order);
+    permute_column(edge_orbit_distances, order);
+    permute_column(edge_orbit_tilts, order);
+    permute_column(edge_orbit_eccentricities, order);
+    int edge{0};
+    for(int position{0}; position < object_amount; position++){
+        int object_id{object_id_column[position]};
+        if(edge_counts[position] == 0){
+            continue;
+        }
+        first_edges[object_id] = edge;
+        for(int i{0}; i < edge_counts[position]; i++, edge++){
+            next_edges[edge] = edge + 1;
+            parent_edges[edge_child_ids[edge]] = edge;
+        }
+        next_edges[edge - 1] = -1;
+        last_edges[object_id] = edge - 1;
+    }
+}
+
+void celestial_objects::catalogue::add_member(std::string parent_name, std::string child_name)
+{
+    /* Parents one catalogue object to another by name, asking the user for the orbital parameters as a satellite does.
+    Throws an int if either object does not exist. */
+    get_object(parent_name);
+    std::shared_ptr<celestial_object> child_ptr{get_object(child_name)};
+    int parent_position{find_position(parent_name)};
+    int child_position{find_position(child_name)};
+    if(can_link(parent_position, child_position)){
+        satellite orbit(child_ptr);
+        link_objects(parent_position, child_position, orbit.orbit_distance, orbit.orbit_tilt, orbit.orbit_eccentricity);
+    }
+}
+
+void celestial_objects::catalogue::add_member(int parent_position, int child_position, double orb_distance, double orb_tilt, double orb_eccentricity)
+{
+    /* Parents the object at child_position to the object at parent_position. Relationships between catalogue objects must be
+    made through here rather than on the objects directly, as the catalogue keeps its own hierarchy store. */
+    if(parent_position < 0 || parent_position >= object_amount || child_position < 0 || child_position >= object_amount){
+        std::cout << "Index out of range. " << std::endl;
+        throw(-1);
+    }
+    if(can_link(parent_position, child_position)){
+        link_objects(parent_position, child_position, orb_distance, orb_tilt, orb_eccentricity);
+    }
+}
+
+bool celestial_objects::catalogue::can_link(int parent_position, int child_position)
+{
+    /* Checks that the object at child_position may be parented to the object at parent_position, explaining why not if it may not.
+    Objects may only have one parent, and may not be parented to themselves or to any of their own descendants, as closed loops
+    would be self-ownership. */
+    int parent_id{object_id_column[parent_position]};
+    int child_id{object_id_column[child_position]};
+    if(parent_ids[child_id] != -1){
+        celestial_object* current_parent{catalogue_objects[object_positions[parent_ids[child_id]]].get()};
+        std::cout << "Object is already parented to " << celestial_types_output[int(current_parent->object_type)] << " '" <<
+        current_parent->name << "'. " << std::endl;
+        return false;
+    } else if(parent_id == child_id){
+        std::cout << "Cannot parent an object to itself! " << std::endl;
+        return false;
+    }
+    //The child has no parent here so is the root of its own tree, and a loop would only be made if the parent is in that tree
+    if(hierarchy_root(parent_id) == child_id){
+        std::cout << "Cannot parent to object, illegal closed parent/child loop would be created. " << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void celestial_objects::catalogue::link_objects(int parent_position, int child_position, double orb_distance, double orb_tilt, double orb_eccentricity)
+{
+    //Adds an edge from the parent to the end of its member list, once can_link() has allowed it, and records it for the next save
+    int parent_id{object_id_column[parent_position]};
+    int child_id{object_id_column[child_position]};
+    int edge{int(edge_child_ids.size())};
+    edge_child_ids.push_back(child_id);
+    next_edges.push_back(-1);
+    edge_orbit_distances.push_back(orb_distance);
+    edge_orbit_tilts.push_back(orb_tilt);
+    edge_orbit_eccentricities.push_back(orb_eccentricity);
+    parent_ids[child_id] = parent_id;
+    parent_edges[child_id] = edge;
+    if(last_edges[parent_id] == -1){
+        first_edges[parent_id] = edge;
+    } else{
+        next_edges[last_edges[parent_id]] = edge;
+    }
+    last_edges[parent_id] = edge;
+    join_hierarchy_sets(parent_id, child_id);
+    update_member_number(parent_position, member_number_column[parent_position] + 1);
+    if(!indexes_deferred){
+        new_relationships.push_back(edge);
+        add_to_system_totals(parent_id, child_id, edge);
+    }
+    log_relationship(edge);
+}
+
+void celestial_objects::catalogue::join_hierarchy_sets(int parent_id, int child_id)
+{
+    /* Merges the child's tree into the parent's, with the smaller set placed under the larger so that paths stay short.
+    The offset is chosen so that every object in the child's tree ends up one deeper than the parent per level as before. */
+    int parent_sum{0};
+    int child_sum{0};
+    int parent_set{find_hierarchy_set(parent_id, parent_sum)};
+    int child_set{find_hierarchy_set(child_id, child_sum)};
+    int offset{parent_sum + 1 - child_sum};
+    if(hierarchy_sizes[child_set] <= hierarchy_sizes[parent_set]){
+        hierarchy_links[child_set] = parent_set;
+        depth_offsets[child_set] = offset;
+        hierarchy_sizes[parent_set] += hierarchy_sizes[child_set];
+    } else{
+        hierarchy_links[parent_set] = child_set;
+        depth_offsets[parent_set] = -offset;
+        hierarchy_sizes[child_set] += hierarchy_sizes[parent_set];
+        hierarchy_roots[child_set] = hierarchy_roots[parent_set];
+    }
+}
+
+std::vector<celestial_objects::link_error> celestial_objects::catalogue::link_all(const std::vector<object_relationship>& relationships)
+{
+    /* Makes a whole list of relationships at once, with the same outcome as passing each to add_member() in turn, but giving back
+    the relationships that were refused and why instead of printing a message for each. All of the relationships are checked in
+    one pass before any edges are made: a child is claimed by the first relationship naming it, and the hierarchy's union-find
+    refuses any that would close a loop. The accepted edges are then laid out together, with each parent's new members in one
+    contiguous block appended to its member list. */
+    std::vector<link_error> errors;
+    std::vector<std::size_t> accepted;
+    accepted.reserve(relationships.size());
+    for(std::size_t i{0}; i < relationships.size(); i++){
+        const object_relationship& relationship{relationships[i]};
+        if(relationship.parent_position < 0 || relationship.parent_position >= object_amount
+        || relationship.child_position < 0 || relationship.child_position >= object_amount){
+            errors.push_back(link_error{i, link_errors::OutOfRange});
+            continue;
+        }
+        int parent_id{object_id_column[relationship.parent_position]};
+        int child_id{object_id_column[relationship.child_position]};
+        if(parent_ids[child_id] != -1){
+            errors.push_back(link_error{i, link_errors::AlreadyParented});
+        } else if(parent_id == child_id){
+            errors.push_back(link_error{i, link_errors::SelfParent});
+        } else if(hierarchy_root(parent_id) == child_id){
+            errors.push_back(link_error{i, link_errors::ClosedLoop});
+        } else{
+            //The child is claimed and the trees merged straight away, so that later relationships are checked against this one
+            parent_ids[child_id] = parent_id;
+            join_hierarchy_sets(parent_id, child_id);
+            accepted.push_back(i);
+        }
+    }
+    if(accepted.empty()){
+        return errors;
+    }
+
+    //Counts the new members of each parent to find where its block of edges starts
+    std::vector<int> block_starts(object_amount + 1, 0);
+    for(std::size_t i : accepted){
+        block_starts[object_id_column[relationships[i].parent_position] + 1]++;
+    }
+    for(int object_id{0}; object_id < object_amount; object_id++){
+        block_starts[object_id + 1] += block_starts[object_id];
+    }
+    int first_new_edge{int(edge_child_ids.size())};
+    std::size_t edge_total{edge_child_ids.size() + accepted.size()};
+    edge_child_ids.resize(edge_total);
+    next_edges.resize(edge_total, -1);
+    edge_orbit_distances.resize(edge_total);
+    edge_orbit_tilts.resize(edge_total);
+    edge_orbit_eccentricities.resize(edge_total);
+    //Relationships keep their order within each parent's block, so members are listed as add_member() would have left them
+    std::vector<int> block_ends(block_starts.begin(), block_starts.end() - 1);
+    for(std::size_t i : accepted){
+        const object_relationship& relationship{relationships[i]};
+        int edge{first_new_edge + block_ends[object_id_column[relationship.parent_position]]++};
+        edge_child_ids[edge] = object_id_column[relationship.child_position];
+        edge_orbit_distances[edge] = relationship.orbit_distance;
+        edge_orbit_tilts[edge] = relationship.orbit_tilt;
+        edge_orbit_eccentricities[edge] = relationship.orbit_eccentricity;
+    }
+    //Each relationship is logged as its own record, but the records are committed together so that the batch costs one sync
+    bool logging{logging_changes()};
+    export_buffer relationship_records;
+    for(int edge{first_new_edge}; edge < int(edge_total); edge++){
+        int child_id{edge_child_ids[edge]};
+        int parent_id{parent_ids[child_id]};
+        parent_edges[child_id] = edge;
+        if(last_edges[parent_id] == -1){
+            first_edges[parent_id] = edge;
+        } else{
+            next_edges[last_edges[parent_id]] = edge;
+        }
+        last_edges[parent_id] = edge;
+        if(!indexes_deferred){
+            new_relationships.push_back(edge);
+        }
+        if(logging){
+            relationship_records << "member:";
+            export_relationship(relationship_records, edge);
+        }
+    }
+    if(logging){
+        write_log_record(relationship_records.contents());
+    }
+    for(int parent_id{0}; parent_id < object_amount; parent_id++){
+        int member_count{block_starts[parent_id + 1] - block_starts[parent_id]};
+        if(member_count > 0){
+            int parent_position{object_positions[parent_id]};
+            update_member_number(parent_position, member_number_column[parent_position] + member_count);
+        }
+    }
+    //A large batch can touch most of the hierarchy, so the system totals are recalculated once rather than path by path
+    if(!indexes_deferred){
+        rebuild_system_totals();
+    }
+    return errors;
+}
+
+void celestial_objects::catalogue::report_link_errors(const std::vector<link_error>& errors)
+{
+    //Outputs how many relationships of an import were refused for each reason, rather than a message for every one
+    std::array<int, link_error_number> error_counts{};
+    for(const link_error& error : errors){
+        error_counts[int(error.error)]++;
+    }
+    const std::array<std::string, link_error_number> error_descriptions{"refer to objects out of range",
+    "have children that are already parented", "would parent objects to themselves", "would create closed parent/child loops"};
+    for(int i{0}; i < link_error_number; i++){
+        if(error_counts[i] > 0){
+            std::cout << error_counts[i] << " relationship(s) " << error_descriptions[i] << " and have not been created. " << std::endl;
+        }
+    }
+}
+
+void celestial_objects::catalogue::export_relationship(export_buffer& relation_data, int edge)
+{
+    //Formats a relationship as a line of the relationship file
+    int child_id{edge_child_ids[edge]};
+    relation_data << object_names.get_name(name_id_column[object_positions[parent_ids[child_id]]]) << ":"
+    << object_names.get_name(name_id_column[object_positions[child_id]])
+    << ":" << edge_orbit_distances[edge] << ":" << edge_orbit_tilts[edge] << ":" << edge_orbit_eccentricities[edge] << '\n';
+}
+
+void celestial_objects::catalogue::export_relationships(export_buffer& relation_data, int position)
+{
+    //Formats the relationships of the object at a position with each of its members, one line each
+    //As objects may only have one parent, if all objects are exported, all relationships will be captured
+    int first_edge{first_edges[object_id_column[position]]};
+    if(first_edge == -1){
+        return;
+    }
+    //Names are read from the name table, whose entries are contiguous, rather than from each member object
+    const std::string& parent_name{object_names.get_name(name_id_column[position])};
+    for(int edge{first_edge}; edge != -1; edge = next_edges[edge]){
+        relation_data << parent_name << ":" << object_names.get_name(name_id_column[object_positions[edge_child_ids[edge]]]) << ":" << edge_orbit_distances[edge]
+        << ":" << edge_orbit_tilts[edge] << ":" << edge_orbit_eccentricities[edge] << '\n';
+    }
+}
+
+int celestial_objects::catalogue::get_parent(int position)
+{
+    //Gives the position of the parent of the object at a position, or -1 if it has none
+    if(position < 0 || position >= object_amount){
+        std::cout << "Index out of range. " << std::endl;
+        throw(-1);
+    }
+    int parent_id{parent_ids[object_id_column[position]]};
+    return parent_id == -1 ? -1 : object_positions[parent_id];
+}
+
+int celestial_objects::catalogue::find_hierarchy_set(int object_id, int& offset_sum)
+{
+    /* Finds the representative of the set holding an object's tree, giving the sum of the depth offsets along the way in offset_sum.
+    The path is compressed as it is walked, with each object on it linked straight to the representative and its offset replaced
+    by the sum from it to the representative, so later finds take close to constant time. */
+    int set{object_id};
+    offset_sum = 0;
+    while(hierarchy_links[set] != set){
+        offset_sum += depth_offsets[set];
+        set = hierarchy_links[set];
+    }
+    int remaining_sum{offset_sum};
+    int current_id{object_id};
+    while(hierarchy_links[current_id] != set){
+        int next_id{hierarchy_links[current_id]};
+        int current_offset{depth_offsets[current_id]};
+        hierarchy_links[current_id] = set;
+        depth_offsets[current_id] = remaining_sum;
+        remaining_sum -= current_offset;
+        current_id = next_id;
+    }
+    return set;
+}
+
+int celestial_objects::catalogue::hierarchy_root(int object_id)
+{
+    //Gives the id of the top object of the tree an object belongs to
+    int offset_sum{0};
+    return hierarchy_roots[find_hierarchy_set(object_id, offset_sum)];
+}
+
+int celestial_objects::catalogue::get_root(int position)
+{
+    //Gives the position of the top object of the hierarchy the object at a position belongs to, being itself if it has no parent
+    if(position < 0 || position >= object_amount){
+        std::cout << "Index out of range. " << std::endl;
+        throw(-1);
+    }
+    return object_positions[hierarchy_root(object_id_column[position])];
+}
+
+int celestial_objects::catalogue::get_depth(int position)
+{
+    //Gives the number of parents above the object at a position, being 0 for objects with no parent
+    if(position < 0 || position >= object_amount){
+        std::cout << "Index out of range. " << std::endl;
+        throw(-1);
+    }
+    int object_sum{0};
+    int root_sum{0};
+    int set{find_hierarchy_set(object_id_column[position], object_sum)};
+    find_hierarchy_set(hierarchy_roots[set], root_sum);
+    return object_sum - root_sum;
+}
+
+void celestial_objects::catalogue::add_to_system_totals(int parent_id, int child_id, int edge)
+{
+    /* Adds the system of a newly linked child, along with the orbit of the edge linking it, to the totals of its new parent and of
+    every object above that. Only the objects on this path have systems that have changed, so nothing else is touched. */
+    double child_mass{system_masses[child_id]};
+    int child_size{system_sizes[child_id]};
+    int child_type{int(type_column[object_positions[child_id]])};
+    double orbit_distance{std::max(edge_orbit_distances[edge], system_orbit_distances[child_id])};
+    const int* child_counts{system_type_counts.data() + std::size_t(child_id)*celestial_type_number};
+    for(int system_id{parent_id}; system_id != -1; system_id = parent_ids[system_id]){
+        system_masses[system_id] += child_mass;
+        system_sizes[system_id] += child_size + 1;
+        int* counts{system_type_counts.data() + std::size_t(system_id)*celestial_type_number};
+        for(int i{0}; i < celestial_type_number; i++){
+            counts[i] += child_counts[i];
+        }
+        counts[child_type]++;
+        system_orbit_distances[system_id] = std::max(system_orbit_distances[system_id], orbit_distance);
+    }
+}
+
+void celestial_objects::catalogue::rebuild_system_totals()
+{
+    /* Recalculates the system totals of every object at once, used after a bulk import in place of adding each relationship's
+    totals up the hierarchy as it is made. Objects are ordered so that every member comes before its parent, so each system
+    is complete by the time it is added to the one above it. */
+    std::vector<int> parent_first_order;
+    parent_first_order.reserve(object_amount);
+    for(int object_id{0}; object_id < object_amount; object_id++){
+        if(parent_ids[object_id] == -1){
+            parent_first_order.push_back(object_id);
+        }
+    }
+    for(std::size_t i{0}; i < parent_first_order.size(); i++){
+        for(int edge{first_edges[parent_first_order[i]]}; edge != -1; edge = next_edges[edge]){
+            parent_first_order.push_back(edge_child_ids[edge]);
+        }
+    }
+    for(int object_id{0}; object_id < object_amount; object_id++){
+        system_masses[object_id] = mass_column[object_positions[object_id]];
+    }
+    std::fill(system_sizes.begin(), system_sizes.end(), 0);
+    std::fill(system_type_counts.begin(), system_type_counts.end(), 0);
+    std::fill(system_orbit_distances.begin(), system_orbit_distances.end(), 0);
+    for(std::size_t i{parent_first_order.size()}; i-- > 0;){
+        int child_id{parent_first_order[i]};
+        int parent_id{parent_ids[child_id]};
+        if(parent_id == -1){
+            continue;
+        }
+        system_masses[parent_id] += system_masses[child_id];
+        system_sizes[parent_id] += system_sizes[child_id] + 1;
+        int* counts{system_type_counts.data() + std::size_t(parent_id)*celestial_type_number};
+        const int* child_counts{system_type_counts.data() + std::size_t(child_id)*celestial_type_number};
+        for(int j{0}; j < celestial_type_number; j++){
+            counts[j] += child_counts[j];
+        }
+        counts[int(type_column[object_positions[child_id]])]++;
+        system_orbit_distances[parent_id] = std::max({system_orbit_distances[parent_id], system_orbit_distances[child_id],
+        edge_orbit_distances[parent_edges[child_id]]});
+    }
+}
+
+double celestial_objects::catalogue::get_system_mass(int position)
+{
+    //Gives the total mass of the object at a position and everything below it
+    if(position < 0 || position >= object_amount){
+        std::cout << "Index out of range. " << std::endl;
+        throw(-1);
+    }
+    return system_masses[object_id_column[position]];
+}
+
+int celestial_objects::catalogue::get_system_size(int position)
+{
+    //Gives the number of objects below the object at a position, at any depth
+    if(position < 0 || position >= object_amount){
+        std::cout << "Index out of range. " << std::endl;
+        throw(-1);
+    }
+    return system_sizes[object_id_column[position]];
+}
+
+int celestial_objects::catalogue::get_system_type_count(int position, celestial_types object_type)
+{
+    //Gives the number of objects of a type below the object at a position, at any depth
+    if(position < 0 || position >= object_amount){
+        std::cout << "Index out of range. " << std::endl;
+        throw(-1);
+    }
+    return system_type_counts[std::size_t(object_id_column[position])*celestial_type_number + int(object_type)];
+}
+
+double celestial_objects::catalogue::get_system_orbit_distance(int position)
+{
+    //Gives the largest orbital distance of any relationship below the object at a position, or 0 if it has no members
+    if(position < 0 || position >= object_amount){
+        std::cout << "Index out of range. " << std::endl;
+        throw(-1);
+    }
+    return system_orbit_distances[object_id_column[position]];
+}
+
+void celestial_objects::catalogue::get_system_properties(int position)
+{
+    //Outputs the system totals of the object at a position, listing only the types that are present below it
+    if(position < 0 || position >= object_amount){
+        std::cout << "Index out of range. " << std::endl;
+        throw(-1);
+    }
+    int object_id{object_id_column[position]};
+    std::cout << "System of " << catalogue_objects[position]->name << ": " << std::endl;
+    std::cout << "Total Mass: " << system_masses[object_id] << " M_Sun, Member Objects: " << system_sizes[object_id]
+    << ", Largest Orbital Distance: " << system_orbit_distances[object_id] << " pc" << std::endl;
+    for(int i{0}; i < celestial_type_number; i++){
+        int count{system_type_counts[std::size_t(object_id)*celestial_type_number + i]};
+        if(count > 0){
+            std::cout << "- " << celestial_types_output[i] << ": " << count << std::endl;
+        }
+    }
+    std::cout << "---------------------------" << std::endl;
+}
+
+celestial_objects::catalogue_selection celestial_objects::catalogue::get_members(int position)
+{
+    //Selects the members of the object at a position, in the order they were added
+    if(position < 0 || position >= object_amount){
+        std::cout << "Index out of range. " << std::endl;
+        throw(-1);
+    }
+    std::vector<int> member_ids;
+    member_ids.reserve(member_number_column[position]);
+    for(int edge{first_edges[object_id_column[position]]}; edge != -1; edge = next_edges[edge]){
+        member_ids.push_back(edge_child_ids[edge]);
+    }
+    return catalogue_selection(this, std::move(member_ids));
+}
+
+int celestial_objects::catalogue::get_member_number(int position)
+{
+    /* Gives the number of members the object at a position has within the catalogue. Catalogue relationships are kept in the
+    hierarchy store rather than in the object's own member list, so the object's get_member_number() does not count them. */
+    if(position < 0 || position >= object_amount){
+        std::cout << "Index out of range. " << std::endl;
+        throw(-1);
+    }
+    return member_number_column[position];
+}
+
+void celestial_objects::catalogue::get_properties(int position)
+{
+    /* Outputs the properties of the object at a position, as celestial_object::get_properties() does, with its children
+    taken from the catalogue's hierarchy store. */
+    if(position < 0 || position >= object_amount){
+        std::cout << "Index out of range. " << std::endl;
+        throw(-1);
+    }
+    export_buffer report_data;
+    write_properties(report_data, position);
+    std::cout << report_data.contents() << std::flush;
+}
+
+void celestial_objects::catalogue::write_properties(export_buffer& report_data, int position)
+{
+    /* Formats the properties of the object at a position and a line for each of its members into a buffer. Only the catalogue's
+    own columns are read for the members, so many objects can be formatted at once on separate threads. */
+    catalogue_objects[position]->write_properties(report_data);
+    int first_edge{first_edges[object_id_column[position]]};
+    if(first_edge != -1){
+        report_data << "Children: \n";
+        for(int edge{first_edge}; edge != -1; edge = next_edges[edge]){
+            int child_position{object_positions[edge_child_ids[edge]]};
+            report_data << "- Name: " << object_names.get_name(name_id_column[child_position]) << ", Type: " << celestial_types_output[int(type_column[child_position])]
+            << ", Number of Children: " << member_number_column[child_position] << '\n';
+            report_data << "  Orbital Distance: " << edge_orbit_distances[edge] << " pc, Orbital Tilt: " << edge_orbit_tilts[edge]
+            << " deg, Orbital Eccentricity: " << edge_orbit_eccentricities[edge] << '\n';
+        }
+    } else{
+        report_data << "No child objects. \n";
+    }
+    report_data << "---------------------------\n";
+}
+
+void celestial_objects::catalogue::update_member_number(int position, int member_number)
+{
+    //Sets the member count of the object at a position, moving the object within the member number index if there is one
+    if(member_number_column[position] == member_number){
+        return;
+    }
+    bool indexed{has_index(parameters::MemberNumber) && !indexes_deferred};
+    if(indexed){
+        remove_from_index(parameters::MemberNumber, object_id_column[position]);
+    }
+    member_number_column[position] = member_number;
+    if(indexed){
+        insert_into_index(parameters::MemberNumber, object_id_column[position]);
+    }
+}
+
+template<typename F>
+void celestial_objects::catalogue::visit_sort_key(parameters parameter, F&& visitor)
+{
+    /* Calls the visitor with a function giving the sort key of the object at a position, so that sorts and indexes can be written
+    once for every parameter. Names are keyed by their case-folded form and enums by their underlying value. Throws an int for an
+    unknown parameter. */
+    switch(parameter)
+    {
+        case celestial_objects::parameters::Name:
+        visitor([this](int position) -> const std::string& {return object_names.get_sort_key(name_id_column[position]);});
+        break;
+
+        case celestial_objects::parameters::CelestialType:
+        visitor([this](int position){return int(type_column[position]);});
+        break;
+
+        case celestial_objects::parameters::HubbleType:
+        visitor([this](int position){return int(hubble_type_column[position]);});
+        break;
+
+        case celestial_objects::parameters::StellarType:
+        visitor([this](int position){return int(stellar_type_column[position]);});
+        break;
+
+        case celestial_objects::parameters::Redshift:
+        case celestial_objects::parameters::Distance:
+        case celestial_objects::parameters::Mass:
+        case celestial_objects::parameters::RotationalVelocity:
+        case celestial_objects::parameters::RightAscension:
+        case celestial_objects::parameters::Declination:
+        {
+            const std::vector<double>& column{numeric_column(parameter)};
+            visitor([&column](int position){return column[position];});
+        }
+        break;
+
+        case celestial_objects::parameters::MemberNumber:
+        visitor([this](int position){return member_number_column[position];});
+        break;
+
+        default:
+        throw int{-1};
+    }
+}
+
+std::vector<int> celestial_objects::catalogue::sorted_order(parameters parameter, bool order_ids)
+{
+    /* Gives every object in order of the given parameter, as positions or, if order_ids is set, as object ids. Ties are broken by
+    the position or id itself, so the order is always fully defined. The catalogue itself is not modified.
+    Each object's key is extracted once up front, so the sort itself never touches the objects or the columns. Names are then
+    merge sorted in parallel, while numeric keys are counting or radix sorted in linear time. */
+    std::vector<int> order(object_amount);
+    if(parameter == celestial_objects::parameters::Name){
+        //Names are sorted on the first 8 bytes of their case-folded key, and the full keys are only compared when those match
+        std::vector<std::pair<std::uint64_t, int>> keys(object_amount);
+        for(int i{0}; i < object_amount; i++){
+            int position{order_ids ? object_positions[i] : i};
+            keys[i] = {name_prefix_key(object_names.get_sort_key(name_id_column[position])), i};
+        }
+        parallel_sort(keys, [&](const std::pair<std::uint64_t, int>& a, const std::pair<std::uint64_t, int>& b)
+        {
+            if(a.first != b.first){
+                return a.first < b.first;
+            }
+            int position_a{order_ids ? object_positions[a.second] : a.second};
+            int position_b{order_ids ? object_positions[b.second] : b.second};
+            int comparison{object_names.get_sort_key(name_id_column[position_a]).compare(object_names.get_sort_key(name_id_column[position_b]))};
+            return comparison < 0 || (comparison == 0 && a.second < b.second);
+        });
+        for(int i{0}; i < object_amount; i++){
+            order[i] = keys[i].second;
+        }
+        return order;
+    }
+    //Every other parameter has a numeric key, so is sorted in linear time. The input is in position or id order and both sorts
+    //are stable, which gives the tie break required.
+    std::iota(order.begin(), order.end(), 0);
+    visit_sort_key(parameter, [&](auto key)
+    {
+        using key_type = std::decay_t<decltype(key(0))>;
+        if constexpr(std::is_same_v<key_type, int>){
+            //Enum parameters, and member numbers in practice, cover a small range of values, which suits a counting sort
+            std::vector<int> keys(object_amount);
+            int minimum_key{0};
+            int maximum_key{0};
+            for(int i{0}; i < object_amount; i++){
+                keys[i] = key(order_ids ? object_positions[i] : i);
+                minimum_key = (i == 0) ? keys[i] : std::min(minimum_key, keys[i]);
+                maximum_key = (i == 0) ? keys[i] : std::max(maximum_key, keys[i]);
+            }
+            if(std::int64_t(maximum_key) - minimum_key < std::max<std::int64_t>(256, object_amount)){
+                counting_sort(keys, minimum_key, maximum_key, order);
+            } else{
+                std::vector<std::uint64_t> radix_keys(object_amount);
+                for(int i{0}; i < object_amount; i++){
+                    radix_keys[i] = radix_key(keys[i]);
+                }
+                radix_sort(radix_keys, order);
+            }
+        } else if constexpr(std::is_same_v<key_type, double>){
+            std::vector<std::uint64_t> radix_keys(object_amount);
+            for(int i{0}; i < object_amount; i++){
+                radix_keys[i] = radix_key(key(order_ids ? object_positions[i] : i));
+            }
+            radix_sort(radix_keys, order);
+        }
+    });
+    return order;
+}
+
+void celestial_objects::catalogue::sort_catalogue(parameters& parameter)
+{
+    /* Sorts the catalogue by the given parameter. If the parameter has a secondary index, its order is used directly.
+    Otherwise a permutation of positions is sorted by comparing column values. Either way the permutation is then applied
+    to the objects, names and columns together. The order is only kept by a full export, as save_changes() appends changed
+    objects rather than rewriting the files, so sorting is neither logged nor counted as a change. */
+    try 
+    {
+        std::vector<int> order;
+        if(has_index(parameter)){
+            order.reserve(object_amount);
+            for(int object_id : sorted_indexes[int(parameter)]){
+                order.push_back(object_positions[object_id]);
+            }
+        } else{
+            order = sorted_order(parameter, false);
+        }
+        apply_permutation(order);
+    } catch(int e){
+        std::cout << "Cannot sort the catalogue by an unknown parameter. " << std::endl;
+    }
+}
+
+void celestial_objects::catalogue::build_index(parameters parameter)
+{
+    /* Fills the secondary index for a parameter from scratch. Object ids break ties, so that tied objects are left in the order
+    they were added, as insert_into_index() expects. */
+    sorted_indexes[int(parameter)].assign(sorted_order(parameter, true));
+}
+
+void celestial_objects::catalogue::rebuild_indexes()
+{
+    //Rebuilds every enabled index and the sky index, used after bulk imports
+    for(int i{0}; i < parameter_number; i++){
+        if(indexed_parameters[i]){
+            build_index(parameters(i));
+        }
+    }
+    build_sky_index();
+}
+
+void celestial_objects::catalogue::insert_into_index(parameters parameter, int object_id)
+{
+    //Binary searches for the object's place in the index by its key, then by id to break ties
+    visit_sort_key(parameter, [&](auto key)
+    {
+        const auto& object_key{key(object_positions[object_id])};
+        sorted_indexes[int(parameter)].insert(object_id, [&](int indexed_id)
+        {
+            const auto& indexed_key{key(object_positions[indexed_id])};
+            return indexed_key < object_key || (!(object_key < indexed_key) && indexed_id < object_id);
+        });
+    });
+}
+
+void celestial_objects::catalogue::remove_from_index(parameters parameter, int object_id)
+{
+    //Must be called before the object's key changes, so that its current entry can be found by binary search
+    visit_sort_key(parameter, [&](auto key)
+    {
+        const auto& object_key{key(object_positions[object_id])};
+        sorted_indexes[int(parameter)].erase(object_id, [&](int indexed_id)
+        {
+            const auto& indexed_key{key(object_positions[indexed_id])};
+            return indexed_key < object_key || (!(object_key < indexed_key) && indexed_id < object_id);
+        });
+    });
+}
+
+void celestial_objects::catalogue::enable_index(parameters parameter)
+{
+    /* Starts maintaining a secondary index for the given parameter. The index is built now and then kept up to date
+    as objects are added or parented, without changing the order of the catalogue itself. */
+    if(!has_index(parameter)){
+        build_index(parameter);
+        indexed_parameters[int(parameter)] = true;
+    }
+}
+
+void celestial_objects::catalogue::disable_index(parameters parameter)
+{
+    indexed_parameters[int(parameter)] = false;
+    sorted_indexes[int(parameter)].clear();
+}
+
+celestial_objects::catalogue_selection celestial_objects::catalogue::sorted_view(parameters parameter)
+{
+    /* Gives a view of the whole catalogue in order of the given parameter, leaving the catalogue's own order alone.
+    The parameter's index is enabled if it was not already, so later views and range scans over it are immediate. */
+    enable_index(parameter);
+    const chunked_index& index{sorted_indexes[int(parameter)]};
+    return catalogue_selection(this, index.ids(index.begin(), index.end()));
+}
+
+celestial_objects::catalogue_selection celestial_objects::catalogue::range_query(parameters parameter, double minimum, double maximum)
+{
+    /* Selects every object whose value of the given parameter lies within [minimum, maximum], in order of that parameter.
+    The range is found by binary search on the parameter's secondary index, which is enabled if it was not already, so a query
+    takes O(log n + k) time for k results. Only numeric parameters can be queried, and others throw an int. */
+    std::vector<int> object_ids;
+    visit_sort_key(parameter, [&](auto key)
+    {
+        using key_type = std::decay_t<decltype(key(0))>;
+        if constexpr(std::is_arithmetic_v<key_type>){
+            if(parameter == parameters::CelestialType || parameter == parameters::HubbleType || parameter == parameters::StellarType){
+                throw int{-1};
+            }
+            enable_index(parameter);
+            const chunked_index& index{sorted_indexes[int(parameter)]};
+            chunked_index::iterator first{index.partition_point([&](int object_id){return key(object_positions[object_id]) < minimum;})};
+            chunked_index::iterator last{index.partition_point([&](int object_id){return !(maximum < key(object_positions[object_id]));})};
+            //An empty range would leave the end of the range before its start
+            if(minimum <= maximum){
+                object_ids = index.ids(first, last);
+            }
+        } else{
+            throw int{-1};
+        }
+    });
+    return catalogue_selection(this, std::move(object_ids));
+}
+
+void celestial_objects::catalogue::set_sky_position(int position, double right_ascension, double declination)
+{
+    /* Moves the object at the given position to a new position on the sky, in degrees, keeping its columns, the sky index and any
+    right ascension or declination index in step. Throws an int if the position is out of range or the coordinates are invalid. */
+    if(position < 0 || position >= object_amount){
+        std::cout << "Index out of range. " << std::endl;
+        throw(-1);
+    } else if(!valid_sky_position(right_ascension, declination)){
+        std::cout << "Right ascension must lie within [0, 360) and declination within [-90, 90]. " << std::endl;
+        throw(-1);
+    }
+    object_parameters parameters{get_parameters(position)};
+    parameters.right_ascension = right_ascension;
+    parameters.declination = declination;
+    update_object(position, parameters);
+}
+
+celestial_objects::object_parameters celestial_objects::catalogue::get_parameters(int position)
+{
+    //Gathers the full set of parameters of the object at a position, as they would be read back from its line in a .dat file
+    celestial_object* object{catalogue_objects[position].get()};
+    object_parameters parameters;
+    parameters.object_type = object->object_type;
+    parameters.name = object->name;
+    parameters.redshift = object->redshift;
+    parameters.distance = object->distance;
+    parameters.mass = object->mass;
+    parameters.rotational_velocity = object->rotational_velocity;
+    parameters.right_ascension = object->right_ascension;
+    parameters.declination = object->declination;
+    if(object->object_type == celestial_types::Galaxy){
+        galaxy* galaxy_object{static_cast<galaxy*>(object)};
+        parameters.stellar_mass_fraction = galaxy_object->stellar_mass_fraction;
+        parameters.hubble_type = galaxy_object->hubble_type;
+    } else if(is_stellar_type(object->object_type)){
+        star* star_object{static_cast<star*>(object)};
+        parameters.star_type = star_object->star_type;
+        parameters.stellar_digit = star_object->stellar_digit;
+        parameters.luminosity_id = star_object->luminosity_id;
+        parameters.abs_magnitude = star_object->abs_magnitude;
+        parameters.app_magnitude = star_object->app_magnitude;
+    }
+    return parameters;
+}
+
+void celestial_objects::catalogue::update_object(int position, const object_parameters& new_parameters)
+{
+    /* Overwrites the data of the object at a position with the new parameters, keeping its name, type, id and relationships, and
+    brings its columns, the indexes and the neighbour tree up to date. The object is recorded as changed for the next save. */
+    celestial_object* object{catalogue_objects[position].get()};
+    int object_id{object_id_column[position]};
+    //Index entries are found by their current keys, so are removed before anything is changed
+    if(!indexes_deferred){
+        for(int i{0}; i < parameter_number; i++){
+            if(indexed_parameters[i]){
+                remove_from_index(parameters(i), object_id);
+            }
+        }
+        remove_from_sky_index(object_id);
+    }
+    //The change in mass is carried up to the system totals of the object and everything above it
+    if(!indexes_deferred){
+        double mass_change{new_parameters.mass - object->mass};
+        for(int system_id{object_id}; system_id != -1; system_id = parent_ids[system_id]){
+            system_masses[system_id] += mass_change;
+        }
+    }
+    object->redshift = new_parameters.redshift;
+    object->distance = new_parameters.distance;
+    object->mass = new_parameters.mass;
+    object->rotational_velocity = new_parameters.rotational_velocity;
+    object->right_ascension = new_parameters.right_ascension;
+    object->declination = new_parameters.declination;
+    if(object->object_type == celestial_types::Galaxy){
+        galaxy* galaxy_object{static_cast<galaxy*>(object)};
+        galaxy_object->stellar_mass_fraction = new_parameters.stellar_mass_fraction;
+        galaxy_object->hubble_type = new_parameters.hubble_type;
+        hubble_type_column[position] = new_parameters.hubble_type;
+    } else if(is_stellar_type(object->object_type)){
+        star* star_object{static_cast<star*>(object)};
+        star_object->star_type = new_parameters.star_type;
+        star_object->stellar_digit = new_parameters.stellar_digit;
+        star_object->luminosity_id = new_parameters.luminosity_id;
+        star_object->abs_magnitude = new_parameters.abs_magnitude;
+        star_object->app_magnitude = new_parameters.app_magnitude;
+        stellar_type_column[position] = new_parameters.star_type;
+    }
+    redshift_column[position] = new_parameters.redshift;
+    distance_column[position] = new_parameters.distance;
+    mass_column[position] = new_parameters.mass;
+    rotational_velocity_column[position] = new_parameters.rotational_velocity;
+    right_ascension_column[position] = new_parameters.right_ascension;
+    declination_column[position] = new_parameters.declination;
+    sky_pixel_column[position] = sky_pixel(new_parameters.right_ascension, new_parameters.declination, sky_index_level);
+    if(!indexes_deferred){
+        for(int i{0}; i < parameter_number; i++){
+            if(indexed_parameters[i]){
+                insert_into_index(parameters(i), object_id);
+            }
+        }
+        insert_into_sky_index(object_id);
+    }
+    neighbour_tree_stale = true;
+    mark_changed(object_id);
+    log_object(position);
+}
+
+void celestial_objects::catalogue::mark_changed(int object_id)
+{
+    //Objects loaded by an import are already in its files, so are not recorded
+    if(indexes_deferred){
+        return;
+    }
+    if(std::size_t(object_id) >= object_changed.size()){
+        object_changed.resize(std::max<std::size_t>(object_amount, std::size_t(object_id) + 1), false);
+    }
+    if(!object_changed[object_id]){
+        object_changed[object_id] = true;
+        changed_objects.push_back(object_id);
+    }
+}
+
+void celestial_objects::catalogue::clear_changes()
+{
+    changed_objects.clear();
+    std::vector<bool>().swap(object_changed);
+    new_relationships.clear();
+}
+
+void celestial_objects::catalogue::save_changes()
+{
+    /* Appends everything added or changed since the catalogue was last loaded or saved to the end of its .dat files, as a delta
+    segment which import_from_file() replays over the rest of the file. Only the changed objects and new relationships are
+    written, so a save takes time in proportion to the changes rather than to the size of the catalogue. A catalogue with no
+    .dat files to append to is exported in full instead. */
+    if(save_path.empty() || !std::filesystem::exists(save_path)){
+        std::cout << "Catalogue '" << catalogue_name << "' has no .dat files to update, so will be exported in full. " << std::endl;
+        export_to_file();
+        return;
+    } else if(!has_changes()){
+        std::cout << "No changes to save. " << std::endl;
+        return;
+    }
+    auto ends_mid_line = [](const std::string& path)
+    {
+        //A file not ending in a newline would have its last line joined onto the delta marker
+        std::ifstream file(path, std::ios::in | std::ios::binary);
+        char last_character{'\n'};
+        if(file.good() && file.seekg(-1, std::ios::end)){
+            file.get(last_character);
+        }
+        return last_character != '\n';
+    };
+    std::string relationship_path{relationship_file_name(save_path)};
+    bool objects_mid_line{ends_mid_line(save_path)};
+    bool relationships_mid_line{ends_mid_line(relationship_path)};
+    std::fstream object_export(save_path, std::ios::out | std::ios::app);
+    std::fstream relationship_export(relationship_path, std::ios::out | std::ios::app);
+    int delta_number{save_sequence + 1};
+    {
+        export_buffer object_data(object_export);
+        export_buffer relationship_data(relationship_export);
+        //Changed objects are written without their relationships, which are either already in the file or recorded as new
+        export_buffer unused_relationships;
+        if(!changed_objects.empty()){
+            object_data << (objects_mid_line ? "\n#delta:" : "#delta:") << delta_number << '\n';
+            for(int object_id : changed_objects){
+                catalogue_objects[object_positions[object_id]]->export_to_file(object_data, unused_relationships);
+            }
+        }
+        if(!new_relationships.empty()){
+            relationship_data << (relationships_mid_line ? "\n#delta:" : "#delta:") << delta_number << '\n';
+            for(int edge : new_relationships){
+                export_relationship(relationship_data, edge);
+            }
+        }
+    }
+    if(!object_export.good() || !relationship_export.good()){
+        std::cout << "ERROR: The changes could not be completely written to disk. " << std::endl;
+        return;
+    }
+    std::cout << changed_objects.size() << " changed object(s) and " << new_relationships.size() << " new relationship(s) saved to '"
+    << save_path << "'. " << std::endl;
+    save_sequence = delta_number;
+    clear_changes();
+    restart_operation_log();
+}
+
+celestial_objects::catalogue_selection celestial_objects::catalogue::cone_search(double right_ascension, double declination, double radius)
+{
+    /* Selects every object within radius degrees of the given sky position, in the order the objects were added. The search is
+    made at the coarsest pixel level whose pixels are still about as wide as the cone, and only the pixels overlapping the cone's
+    bounding box are visited. Each of these is a contiguous run of the sky index, so only objects in those runs are tested against
+    the cone itself. Throws an int if the centre or radius are invalid. */
+    if(!valid_sky_position(right_ascension, declination) || !(radius >= 0)){
+        throw int{-1};
+    }
+    radius = std::min(radius, 180.0);
+    int level{0};
+    while(level < sky_index_level && 180.0 / double(std::uint32_t{1} << (level + 1)) >= radius){
+        level++;
+    }
+    std::uint32_t rows{std::uint32_t{1} << level};
+    std::uint32_t columns{2 * rows};
+    //The box is widened very slightly so that objects on its edge are not lost to rounding
+    double search_radius{radius + 1e-9};
+    auto row_of = [rows](double dec)
+    {
+        double row{std::floor((std::sin(dec * degrees_to_radians) + 1) / 2 * rows)};
+        return std::uint32_t(std::min(double(rows - 1), std::max(0.0, row)));
+    };
+    std::uint32_t first_row{row_of(std::max(-90.0, declination - search_radius))};
+    std::uint32_t last_row{row_of(std::min(90.0, declination + search_radius))};
+
+    //A cone containing a pole covers every right ascension, otherwise its widest extent is at the centre's declination
+    std::int64_t first_column{0};
+    std::int64_t last_column{std::int64_t(columns) - 1};
+    if(declination + search_radius < 90 && declination - search_radius > -90){
+        double width_sine{std::sin(search_radius * degrees_to_radians) / std::cos(declination * degrees_to_radians)};
+        if(width_sine < 1){
+            double half_width{std::asin(width_sine) / degrees_to_radians};
+            double column_width{360.0 / columns};
+            std::int64_t lowest_column{std::int64_t(std::floor((right_ascension - half_width) / column_width))};
+            std::int64_t highest_column{std::int64_t(std::floor((right_ascension + half_width) / column_width))};
+            if(highest_column - lowest_column + 1 < std::int64_t(columns)){
+                first_column = lowest_column;
+                last_column = highest_column;
+            }
+        }
+    }
+
+    //The angular separation is found with the haversine formula, which stays accurate for very small cones
+    int shift{2 * (sky_index_level - level)};
+    double centre_declination{declination * degrees_to_radians};
+    double centre_cosine{std::cos(centre_declination)};
+    double radius_haversine{std::pow(std::sin(radius * degrees_to_radians / 2), 2)};
+    std::vector<int> object_ids;
+    for(std::uint32_t row{first_row}; row <= last_row; row++){
+        for(std::int64_t column{first_column}; column <= last_column; column++){
+            //Columns are wrapped around, as a cone may straddle a right ascension of zero
+            std::uint32_t wrapped_column{std::uint32_t(((column % columns) + columns) % columns)};
+            std::uint32_t pixel{nested_pixel(row, wrapped_column, level)};
+            std::uint32_t run_first_pixel{pixel << shift};
+            std::uint32_t run_end_pixel{(pixel + 1) << shift};
+            chunked_index::iterator run_begin{sky_index.partition_point([&](int object_id)
+            {return sky_pixel_column[object_positions[object_id]] < run_first_pixel;})};
+            for(chunked_index::iterator i{run_begin}; i != sky_index.end(); ++i){
+                int position{object_positions[*i]};
+                if(sky_pixel_column[position] >= run_end_pixel){
+                    break;
+                }
+                double object_declination{declination_column[position] * degrees_to_radians};
+                double separation_haversine{std::pow(std::sin((object_declination - centre_declination) / 2), 2) + centre_cosine
+                * std::cos(object_declination) * std::pow(std::sin((right_ascension_column[position] - right_ascension) * degrees_to_radians / 2), 2)};
+                if(separation_haversine <= radius_haversine){
+                    object_ids.push_back(*i);
+                }
+            }
+        }
+    }
+    std::sort(object_ids.begin(), object_ids.end());
+    return catalogue_selection(this, std::move(object_ids));
+}
+
+void celestial_objects::catalogue::build_sky_index()
+{
+    //Radix sorts every object id by its pixel, which keeps ids with the same pixel in the order they were added
+    std::vector<std::uint64_t> keys(object_amount);
+    std::vector<int> object_ids(object_amount);
+    for(int object_id{0}; object_id < object_amount; object_id++){
+        keys[object_id] = sky_pixel_column[object_positions[object_id]];
+        object_ids[object_id] = object_id;
+    }
+    radix_sort(keys, object_ids);
+    sky_index.assign(object_ids);
+}
+
+void celestial_objects::catalogue::insert_into_sky_index(int object_id)
+{
+    //Binary searches for the object's place in the index by its pixel, then by id to break ties
+    std::uint32_t pixel{sky_pixel_column[object_positions[object_id]]};
+    sky_index.insert(object_id, [&](int indexed_id)
+    {
+        std::uint32_t indexed_pixel{sky_pixel_column[object_positions[indexed_id]]};
+        return indexed_pixel < pixel || (indexed_pixel == pixel && indexed_id < object_id);
+    });
+}
+
+void celestial_objects::catalogue::remove_from_sky_index(int object_id)
+{
+    //Must be called before the object's pixel changes, so that its current entry can be found by binary search
+    std::uint32_t pixel{sky_pixel_column[object_positions[object_id]]};
+    sky_index.erase(object_id, [&](int indexed_id)
+    {
+        std::uint32_t indexed_pixel{sky_pixel_column[object_positions[indexed_id]]};
+        return indexed_pixel < pixel || (indexed_pixel == pixel && indexed_id < object_id);
+    });
+}
+
+celestial_objects::cartesian_position celestial_objects::catalogue::object_cartesian_position(int position)const
+{
+    //Converts an object's sky position and distance into a position in space
+    double right_ascension{right_ascension_column[position] * degrees_to_radians};
+    double declination{declination_column[position] * degrees_to_radians};
+    double distance{distance_column[position]};
+    return cartesian_position{distance * std::cos(declination) * std::cos(right_ascension), distance * std::cos(declination)
+    * std::sin(right_ascension), distance * std::sin(declination)};
+}
+
+const celestial_objects::kd_tree& celestial_objects::catalogue::neighbour_index()
+{
+    //Rebuilds the tree from the columns if objects have been added or moved since it was last built
+    if(neighbour_tree_stale){
+        std::vector<cartesian_position> positions(object_amount);
+        for(int i{0}; i < object_amount; i++){
+            positions[i] = object_cartesian_position(i);
+        }
+        neighbour_tree.build(positions, object_id_column);
+        neighbour_tree_stale = false;
+    }
+    return neighbour_tree;
+}
+
+celestial_objects::catalogue_selection celestial_objects::catalogue::nearest_neighbours(int position, int k)
+{
+    /* Selects the k objects closest in space to the object at the given position, nearest first, not counting the object itself.
+    Positions in space come from each object's right ascension, declination and distance. Throws an int if the position is out of
+    range or k is negative. */
+    if(position < 0 || position >= object_amount){
+        std::cout << "Index out of range. " << std::endl;
+        throw(-1);
+    } else if(k < 0){
+        throw int{-1};
+    }
+    std::vector<std::pair<double, int>> nearest{neighbour_index().nearest(object_cartesian_position(position), k, object_id_column[position])};
+    std::vector<int> object_ids;
+    object_ids.reserve(nearest.size());
+    for(const std::pair<double, int>& neighbour : nearest){
+        object_ids.push_back(neighbour.second);
+    }
+    return catalogue_selection(this, std::move(object_ids));
+}
+
+celestial_objects::catalogue_selection celestial_objects::catalogue::neighbours_within(int position, double radius)
+{
+    /* Selects every object within radius parsecs of the object at the given position, nearest first, not counting the object
+    itself. Throws an int if the position is out of range or the radius is negative. */
+    if(position < 0 || position >= object_amount){
+        std::cout << "Index out of range. " << std::endl;
+        throw(-1);
+    } else if(!(radius >= 0)){
+        throw int{-1};
+    }
+    std::vector<std::pair<double, int>> found{neighbour_index().within(object_cartesian_position(position), radius, object_id_column[position])};
+    std::vector<int> object_ids;
+    object_ids.reserve(found.size());
+    for(const std::pair<double, int>& neighbour : found){
+        object_ids.push_back(neighbour.second);
+    }
+    return catalogue_selection(this, std::move(object_ids));
+}
+
+template<typename F>
+std::vector<celestial_objects::catalogue_selection> celestial_objects::catalogue::run_neighbour_queries(const std::vector<int>& positions, F&& query)
+{
+    /* Runs a neighbour query for every given position, splitting the positions between worker threads. The tree is brought up to
+    date before any worker starts, after which the queries only read from the catalogue. Throws an int, before any query is run,
+    if any position is out of range. */
+    for(int position : positions){
+        if(position < 0 || position >= object_amount){
+            std::cout << "Index out of range. " << std::endl;
+            throw(-1);
+        }
+    }
+    neighbour_index();
+    std::vector<catalogue_selection> results(positions.size());
+    int worker_number{choose_worker_count(positions.size(), 1024)};
+    auto run_queries = [&](std::size_t begin, std::size_t end)
+    {
+        for(std::size_t i{begin}; i < end; i++){
+            results[i] = query(positions[i]);
+        }
+    };
+    std::vector<std::thread> workers;
+    for(int i{1}; i < worker_number; i++){
+        workers.emplace_back(run_queries, positions.size() * std::size_t(i) / std::size_t(worker_number),
+        positions.size() * std::size_t(i + 1) / std::size_t(worker_number));
+    }
+    run_queries(0, positions.size() / std::size_t(worker_number));
+    for(std::thread& worker : workers){
+        worker.join();
+    }
+    return results;
+}
+
+std::vector<celestial_objects::catalogue_selection> celestial_objects::catalogue::nearest_neighbours(const std::vector<int>& positions, int k)
+{
+    //Finds the k nearest neighbours of each of the given objects, as nearest_neighbours() does for one, running the queries in parallel
+    if(k < 0){
+        throw int{-1};
+    }
+    return run_neighbour_queries(positions, [this, k](int position){return nearest_neighbours(position, k);});
+}
+
+std::vector<celestial_objects::catalogue_selection> celestial_objects::catalogue::neighbours_within(const std::vector<int>& positions, double radius)
+{
+    //Finds every neighbour within radius parsecs of each of the given objects, running the queries in parallel
+    if(!(radius >= 0)){
+        throw int{-1};
+    }
+    return run_neighbour_queries(positions, [this, radius](int position){return neighbours_within(position, radius);});
+}
+
+void celestial_objects::catalogue::apply_permutation(const std::vector<int>& order)
+{
+    /* Reorders the catalogue so that the object at position i is the one previously at order[i], then moves each name's
+    index entry to its new position. */
+    permute_column(catalogue_objects, order);
+    permute_column(name_id_column, order);
+    permute_column(object_id_column, order);
+    permute_column(redshift_column, order);
+    permute_column(distance_column, order);
+    permute_column(mass_column, order);
+    permute_column(rotational_velocity_column, order);
+    permute_column(right_ascension_column, order);
+    permute_column(declination_column, order);
+    permute_column(sky_pixel_column, order);
+    permute_column(type_column, order);
+    permute_column(hubble_type_column, order);
+    permute_column(stellar_type_column, order);
+    permute_column(member_number_column, order);
+    for(int position{0}; position < object_amount; position++){
+        name_positions[name_id_column[position]] = position;
+        object_positions[object_id_column[position]] = position;
+    }
+}
+
+const std::vector<double>& celestial_objects::catalogue::numeric_column(parameters parameter)
+{
+    //Gives the dense column for a floating point parameter, throwing an int for any parameter that isn't stored as a double
+    switch(parameter)
+    {
+        case celestial_objects::parameters::Redshift:
+        return redshift_column;
+
+        case celestial_objects::parameters::Distance:
+        return distance_column;
+
+        case celestial_objects::parameters::Mass:
+        return mass_column;
+
+        case celestial_objects::parameters::RotationalVelocity:
+        return rotational_velocity_column;
+
+        case celestial_objects::parameters::RightAscension:
+        return right_ascension_column;
+
+        case celestial_objects::parameters::Declination:
+        return declination_column;
+
+        default:
+        throw int{-1};
+    }
+}
+
+std::vector<int> celestial_objects::catalogue::filter_catalogue(parameters parameter, double minimum, double maximum)
+{
+    /* Returns the positions of every object whose value of the given numeric parameter lies within [minimum, maximum].
+    The positions are valid until the catalogue is next sorted or added to. Throws an int for non-numeric parameters. */
+    std::vector<int> positions;
+    auto scan_column = [&](const auto& column)
+    {
+        for(int i{0}; i < object_amount; i++){
+            if(column[i] >= minimum && column[i] <= maximum){
+                positions.push_back(i);
+            }
+        }
+    };
+    if(parameter == celestial_objects::parameters::MemberNumber){
+        scan_column(member_number_column);
+    } else{
+        scan_column(numeric_column(parameter));
+    }
+    return positions;
+}
+
+celestial_objects::parameter_statistics celestial_objects::catalogue::get_statistics(parameters parameter)
+{
+    /* Calculates the count, sum, mean, minimum and maximum of a numeric parameter over the whole catalogue. An empty
+    catalogue gives all zeros. Throws an int for non-numeric parameters. */
+    parameter_statistics statistics;
+    auto summarise_column = [&](const auto& column)
+    {
+        if(column.empty()){
+            return;
+        }
+        statistics.count = int(column.size());
+        statistics.minimum = column[0];
+        statistics.maximum = column[0];
+        for(const auto& value : column){
+            statistics.sum += value;
+            statistics.minimum = std::min<double>(statistics.minimum, value);
+            statistics.maximum = std::max<double>(statistics.maximum, value);
+        }
+        statistics.mean = statistics.sum / statistics.count;
+    };
+    if(parameter == celestial_objects::parameters::MemberNumber){
+        summarise_column(member_number_column);
+    } else{
+        summarise_column(numeric_column(parameter));
+    }
+    return statistics;
+}
+
+std::shared_ptr<celestial_objects::celestial_object> celestial_objects::catalogue::get_object(std::string name)
+{
+    //Names are unique identifiers, so the name table gives the object's position directly
+    int object_position{find_position(name)};
+    if(object_position == -1){
+        std::cout << "Object not found, please enter another name. ";
+        throw(-1);
+    } else{
+        return catalogue_objects[object_position];
+    }
+}
+
+int celestial_objects::catalogue::find_position(std::string_view name)const
+{
+    //Gives the position of the object with the given name, or -1 if there is no such object in the catalogue
+    int name_id{object_names.find(name)};
+    if(name_id == -1){
+        return -1;
+    }
+    return name_positions[name_id];
+}
+
+std::vector<std::string_view> celestial_objects::catalogue::get_obj_names()
+{
+    //Names are returned in catalogue order, as views into the name table that remain valid for as long as the catalogue exists
+    std::vector<std::string_view> names;
+    names.reserve(object_amount);
+    for(int name_id : name_id_column){
+        names.push_back(object_names.get_name(name_id));
+    }
+    return names;
+}
+
+std::shared_ptr<celestial_objects::celestial_object> celestial_objects::catalogue::get_object(int index)
+{
+    if(index < 0 || index >= catalogue_objects.size()){
+        std::cout << "Index out of range. " << std::endl;
+        throw(-1);
+    } else{
+        return catalogue_objects[index];
+    }
+}
+
+std::vector<std::shared_ptr<celestial_objects::celestial_object>> celestial_objects::catalogue::subselect_catalogue(celestial_objects::celestial_types& type)
+{
+    /* Returns every object of the given type, including objects of derived types, so that derived objects are captured when
+    their base classes are requested. Unassigned selects the whole catalogue. */
+    std::vector<std::shared_ptr<celestial_objects::celestial_object>> subselection;
+    std::vector<int> positions{select_types(type_bit(type))};
+    subselection.reserve(positions.size());
+    for(int position : positions){
+        subselection.push_back(catalogue_objects[position]);
+    }
+    return subselection;
+}
+
+std::vector<int> celestial_objects::catalogue::select_types(type_mask requested_types)
+{
+    /* Returns the positions of every object whose type, or any type it derives from, is in the requested set. The type column is
+    scanned in a single pass, and every position is written with the output only advancing on a match, so there is no branch on
+    the object type. */
+    std::vector<int> positions(object_amount);
+    int match_number{0};
+    for(int i{0}; i < object_amount; i++){
+        positions[match_number] = i;
+        match_number += int((type_ancestry[int(type_column[i])] & requested_types) != 0);
+    }
+    positions.resize(match_number);
+    return positions;
+}
+
+celestial_objects::catalogue_selection celestial_objects::catalogue::make_selection(const std::vector<int>& positions)
+{
+    //Converts positions, such as those given by select_types() or filter_catalogue(), into a selection which survives reordering
+    std::vector<int> ids;
+    ids.reserve(positions.size());
+    for(int position : positions){
+        ids.push_back(object_id_column[position]);
+    }
+    return catalogue_selection(this, std::move(ids));
+}
+
+celestial_objects::catalogue_selection celestial_objects::catalogue::select_all()
+{
+    //Selects every object in the catalogue, in its current order, as a view over the live id column rather than a copy of it
+    return catalogue_selection(this);
+}
+
+void celestial_objects::catalogue::generate_report()
+{
+    generate_report(std::cout, report_modes::Full);
+}
+
+void celestial_objects::catalogue::write_report_summary(export_buffer& report_data)
+{
+    //Formats the opening summary of a report, whose figures come straight from the column store without visiting the objects
+    report_data << "Catalogue: " << catalogue_name << '\n';
+    report_data << "Total number of objects: " << object_amount << '\n';
+    if(object_amount > 0){
+        parameter_statistics redshift_statistics{get_statistics(celestial_objects::parameters::Redshift)};
+        parameter_statistics distance_statistics{get_statistics(celestial_objects::parameters::Distance)};
+        report_data << "Average redshift: " << redshift_statistics.mean << " (min " << redshift_statistics.minimum
+                << ", max " << redshift_statistics.maximum << ")\n";
+        report_data << "Average distance: " << distance_statistics.mean << " (min " << distance_statistics.minimum
+                << ", max " << distance_statistics.maximum << ")\n";
+        std::vector<int> type_counts(celestial_objects::celestial_types_output.size(), 0);
+        for(celestial_objects::celestial_types type : type_column){
+            type_counts[int(type)]++;
+        }
+        report_data << "Objects of each type: \n";
+        for(int i{0}; i < int(type_counts.size()); i++){
+            if(type_counts[i] > 0){
+                report_data << "  " << celestial_objects::celestial_types_output[i] << ": " << type_counts[i] << '\n';
+            }
+        }
+    }
+}
+
+void celestial_objects::catalogue::generate_report(std::ostream& output, report_modes mode)
+{
+    /* Writes a report of the catalogue to a stream: a summary, followed by the properties of every object unless only the summary
+    is wanted. Objects are rendered in rounds, with each round split into slices that are formatted into separate buffers on
+    separate threads, then the buffers are written out in catalogue order in large blocks. In paged mode each round is one page,
+    after which the user is asked whether to continue. */
+    export_buffer summary_data;
+    write_report_summary(summary_data);
+    summary_data.write_to(output);
+    if(mode == report_modes::Summary){
+        output.flush();
+        return;
+    }
+    output << "Object information: \n";
+    output << "----------------------------\n";
+    std::size_t object_number{std::size_t(object_amount)};
+    std::size_t round_size{mode == report_modes::Paged ? report_page_size : object_number};
+    int worker_number{choose_worker_count(std::min(round_size, object_number), report_objects_per_worker)};
+    if(mode != report_modes::Paged){
+        round_size = std::size_t(worker_number) * report_objects_per_worker;
+    }
+    std::size_t slice_size{(round_size + worker_number - 1) / worker_number};
+    std::vector<export_buffer> report_buffers(worker_number);
+    auto render_slice = [&](int worker, std::size_t begin, std::size_t end)
+    {
+        for(std::size_t i{begin}; i < end; i++){
+            write_properties(report_buffers[worker], int(i));
+            report_buffers[worker] << '\n';
+        }
+    };
+    for(std::size_t round_begin{0}; round_begin < object_number; round_begin += round_size){
+        std::size_t round_end{std::min(object_number, round_begin + round_size)};
+        std::vector<std::thread> workers;
+        for(int i{1}; i < worker_number; i++){
+            std::size_t slice_begin{std::min(round_end, round_begin + std::size_t(i) * slice_size)};
+            workers.emplace_back(render_slice, i, slice_begin, std::min(round_end, slice_begin + slice_size));
+        }
+        render_slice(0, round_begin, std::min(round_end, round_begin + slice_size));
+        for(std::thread& worker : workers){
+            worker.join();
+        }
+        for(export_buffer& report_buffer : report_buffers){
+            report_buffer.write_to(output);
+        }
+        if(mode == report_modes::Paged && round_end < object_number){
+            output.flush();
+            std::string answer{""};
+            std::cout << "Objects " << round_begin + 1 << " to " << round_end << " of " << object_number
+            << " shown. Press enter to show the next page, or type 'q' to stop: ";
+            if(!std::getline(std::cin, answer) || answer == "q"){
+                break;
+            }
+        }
+    }
+    output.flush();
+}
+
+bool celestial_objects::catalogue::generate_report(const std::string& file_name, report_modes mode)
+{
+    //Writes a report of the catalogue to a file, replacing anything already in it, as there is no one to turn the pages of a file
+    std::ofstream report_file(file_name, std::ios::out | std::ios::trunc);
+    if(!report_file.is_open()){
+        std::cout << "ERROR: Report file '" << file_name << "' could not be opened. " << std::endl;
+        return false;
+    }
+    generate_report(report_file, mode == report_modes::Paged ? report_modes::Full : mode);
+    if(!report_file.good()){
+        std::cout << "ERROR: The report could not be completely written to '" << file_name << "'. " << std::endl;
+        return false;
+    }
+    return true;
+}
+
+const std::string& celestial_objects::catalogue::get_name()const
+{
+    return catalogue_name;
+}
+
+bool celestial_objects::name_sort(const std::string& name_a, const std::string& name_b)
+{
+    //Compares names case-insensitively, one character at a time, so neither name has to be copied
+    return std::lexicographical_compare(name_a.begin(), name_a.end(), name_b.begin(), name_b.end(), [](char a, char b)
+    {return std::tolower((unsigned char)a) < std::tolower((unsigned char)b);});
+}
+
+std::uint64_t celestial_objects::hash_name(std::string_view name)
+{
+    //64-bit FNV-1a hash, which is quick for the short strings used as names
+    std::uint64_t hash{14695981039346656037ull};
+    for(char character : name){
+        hash ^= std::uint64_t((unsigned char)character);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+int celestial_objects::name_table::intern(std::string_view name)
+{
+    /* Returns the id of the given name, adding it to the table first if it is not already present. */
+    if(2 * (names.size() + 1) > slots.size()){
+        rehash(std::max<std::size_t>(16, 2 * slots.size()));
+    }
+    std::uint64_t hash{hash_name(name)};
+    std::size_t mask{slots.size() - 1};
+    std::size_t slot{std::size_t(hash) & mask};
+    while(slots[slot] != -1){
+        int id{slots[slot]};
+        if(hashes[id] == hash && names[id] == name){
+            return id;
+        }
+        slot = (slot + 1) & mask;
+    }
+    int id{int(names.size())};
+    names.emplace_back(name);
+    std::string sort_key{name};
+    for(char& character : sort_key){
+        character = char(std::tolower((unsigned char)character));
+    }
+    sort_keys.push_back(std::move(sort_key));
+    hashes.push_back(hash);
+    slots[slot] = id;
+    return id;
+}
+
+int celestial_objects::name_table::find(std::string_view name)const
+{
+    /* Returns the id of the given name, or -1 if it has not been added to the table. */
+    if(slots.empty()){
+        return -1;
+    }
+    std::uint64_t hash{hash_name(name)};
+    std::size_t mask{slots.size() - 1};
+    std::size_t slot{std::size_t(hash) & mask};
+    while(slots[slot] != -1){
+        int id{slots[slot]};
+        if(hashes[id] == hash && names[id] == name){
+            return id;
+        }
+        slot = (slot + 1) & mask;
+    }
+    return -1;
+}
+
+void celestial_objects::name_table::reserve(std::size_t name_number)
+{
+    //Allows an import to size the table once for every name it is about to add
+    names.reserve(name_number);
+    sort_keys.reserve(name_number);
+    hashes.reserve(name_number);
+    std::size_t slot_number{16};
+    while(slot_number < 2 * name_number){
+        slot_number *= 2;
+    }
+    if(slot_number > slots.size()){
+        rehash(slot_number);
+    }
+}
+
+void celestial_objects::chunked_index::assign(const std::vector<int>& ids)
+{
+    //Chunks are filled to half the limit, leaving room for insertions before any of them needs to be split
+    constexpr std::size_t fill{index_chunk_size / 2};
+    std::vector<std::vector<int>> new_chunks;
+    new_chunks.reserve((ids.size() + fill - 1) / fill);
+    for(std::size_t first{0}; first < ids.size(); first += fill){
+        new_chunks.emplace_back(ids.begin() + std::ptrdiff_t(first), ids.begin() + std::ptrdiff_t(std::min(first + fill, ids.size())));
+    }
+    chunks.swap(new_chunks);
+    id_number = int(ids.size());
+}
+
+std::vector<int> celestial_objects::chunked_index::ids(iterator first, iterator last)const
+{
+    //Copies the ids from first up to last into one array, as a selection holds them
+    std::vector<int> range_ids;
+    for(iterator i{first}; i != last; ++i){
+        range_ids.push_back(*i);
+    }
+    return range_ids;
+}
+
+void celestial_objects::name_table::rehash(std::size_t slot_number)
+{
+    //Rebuilds the slots at a new power of two size from the stored hashes, without rehashing any names
+    slots.assign(slot_number, -1);
+    std::size_t mask{slot_number - 1};
+    for(int id{0}; id < int(names.size()); id++){
+        std::size_t slot{std::size_t(hashes[id]) & mask};
+        while(slots[slot] != -1){
+            slot = (slot + 1) & mask;
+        }
+        slots[slot] = id;
+    }
+}
+
+void celestial_objects::kd_tree::build(const std::vector<cartesian_position>& new_points, const std::vector<int>& new_ids)
+{
+    /* Builds the tree over the given points, where new_ids[i] is the id of new_points[i]. The top levels of the tree are split
+    between threads, as the two halves of each range are built independently. */
+    points = new_points;
+    ids = new_ids;
+    split_axes.assign(points.size(), 0);
+    std::vector<int> order(points.size());
+    std::iota(order.begin(), order.end(), 0);
+    build_range(order, 0, points.size(), choose_worker_count(points.size(), 1 << 16) - 1);
+    permute_column(points, order);
+    permute_column(ids, order);
+}
+
+void celestial_objects::kd_tree::build_range(std::vector<int>& order, std::size_t begin, std::size_t end, int spare_threads)
+{
+    //Places the median point of the range along its widest axis at the middle of the range, then builds each half the same way
+    if(end - begin <= std::size_t(kd_tree_leaf_size)){
+        return;
+    }
+    cartesian_position lower{points[order[begin]]};
+    cartesian_position upper{lower};
+    for(std::size_t i{begin}; i < end; i++){
+        for(int axis{0}; axis < 3; axis++){
+            lower[axis] = std::min(lower[axis], points[order[i]][axis]);
+            upper[axis] = std::max(upper[axis], points[order[i]][axis]);
+        }
+    }
+    int split_axis{0};
+    for(int axis{1}; axis < 3; axis++){
+        if(upper[axis] - lower[axis] > upper[split_axis] - lower[split_axis]){
+            split_axis = axis;
+        }
+    }
+    std::size_t middle{begin + (end - begin) / 2};
+    std::nth_element(order.begin() + begin, order.begin() + middle, order.begin() + end, [this, split_axis](int a, int b)
+    {return points[a][split_axis] < points[b][split_axis];});
+    //Nodes are held at the index of the point they split on, which is where that point ends up once the points are reordered
+    split_axes[middle] = std::uint8_t(split_axis);
+    if(spare_threads > 0){
+        int left_threads{(spare_threads - 1) / 2};
+        std::thread left_worker(&kd_tree::build_range, this, std::ref(order), begin, middle, left_threads);
+        build_range(order, middle + 1, end, spare_threads - 1 - left_threads);
+        left_worker.join();
+    } else{
+        build_range(order, begin, middle, 0);
+        build_range(order, middle + 1, end, 0);
+    }
+}
+
+std::vector<std::pair<double, int>> celestial_objects::kd_tree::nearest(const cartesian_position& point, int k, int excluded_id)const
+{
+    /* Gives the distances and ids of the k points nearest to the given point, nearest first, skipping the point with excluded_id
+    (use -1 to skip nothing). Equally distant points are taken in order of id. */
+    std::vector<std::pair<double, int>> nearest_points;
+    if(k > 0){
+        nearest_points.reserve(std::size_t(k) + 1);
+        search_nearest(point, 0, points.size(), std::size_t(k), excluded_id, nearest_points);
+    }
+    std::sort_heap(nearest_points.begin(), nearest_points.end());
+    for(std::pair<double, int>& neighbour : nearest_points){
+        neighbour.first = std::sqrt(neighbour.first);
+    }
+    return nearest_points;
+}
+
+std::vector<std::pair<double, int>> celestial_objects::kd_tree::within(const cartesian_position& point, double radius, int excluded_id)const
+{
+    /* Gives the distances and ids of every point within radius of the given point, nearest first, skipping the point with excluded_id. */
+    std::vector<std::pair<double, int>> found_points;
+    search_within(point, 0, points.size(), radius * radius, excluded_id, found_points);
+    std::sort(found_points.begin(), found_points.end());
+    for(std::pair<double, int>& neighbour : found_points){
+        neighbour.first = std::sqrt(neighbour.first);
+    }
+    return found_points;
+}
+
+void celestial_objects::kd_tree::search_nearest(const cartesian_position& point, std::size_t begin, std::size_t end, std::size_t k,
+int excluded_id, std::vector<std::pair<double, int>>& nearest)const
+{
+    /* Searches a range for the k nearest points, keeping the best found so far in a max-heap of squared distance and id. The half of
+    the range on the same side of the split as the point is searched first, and the other half is skipped if the splitting plane is
+    further away than the worst point kept. */
+    auto consider = [&](std::size_t i)
+    {
+        if(ids[i] == excluded_id){
+            return;
+        }
+        double dx{points[i][0] - point[0]};
+        double dy{points[i][1] - point[1]};
+        double dz{points[i][2] - point[2]};
+        std::pair<double, int> candidate{dx * dx + dy * dy + dz * dz, ids[i]};
+        if(nearest.size() < k){
+            nearest.push_back(candidate);
+            std::push_heap(nearest.begin(), nearest.end());
+        } else if(candidate < nearest.front()){
+            std::pop_heap(nearest.begin(), nearest.end());
+            nearest.back() = candidate;
+            std::push_heap(nearest.begin(), nearest.end());
+        }
+    };
+    if(end - begin <= std::size_t(kd_tree_leaf_size)){
+        for(std::size_t i{begin}; i < end; i++){
+            consider(i);
+        }
+        return;
+    }
+    std::size_t middle{begin + (end - begin) / 2};
+    consider(middle);
+    double plane_distance{point[split_axes[middle]] - points[middle][split_axes[middle]]};
+    if(plane_distance < 0){
+        search_nearest(point, begin, middle, k, excluded_id, nearest);
+        if(nearest.size() < k || plane_distance * plane_distance <= nearest.front().first){
+            search_nearest(point, middle + 1, end, k, excluded_id, nearest);
+        }
+    } else{
+        search_nearest(point, middle + 1, end, k, excluded_id, nearest);
+        if(nearest.size() < k || plane_distance * plane_distance <= nearest.front().first){
+            search_nearest(point, begin, middle, k, excluded_id, nearest);
+        }
+    }
+}
+
+void celestial_objects::kd_tree::search_within(const cartesian_position& point, std::size_t begin, std::size_t end, double radius_squared,
+int excluded_id, std::vector<std::pair<double, int>>& found)const
+{
+    //Collects every point of a range within the radius, only descending into the halves of the range the sphere reaches
+    auto consider = [&](std::size_t i)
+    {
+        double dx{points[i][0] - point[0]};
+        double dy{points[i][1] - point[1]};
+        double dz{points[i][2] - point[2]};
+        double distance_squared{dx * dx + dy * dy + dz * dz};
+        if(distance_squared <= radius_squared && ids[i] != excluded_id){
+            found.emplace_back(distance_squared, ids[i]);
+        }
+    };
+    if(end - begin <= std::size_t(kd_tree_leaf_size)){
+        for(std::size_t i{begin}; i < end; i++){
+            consider(i);
+        }
+        return;
+    }
+    std::size_t middle{begin + (end - begin) / 2};
+    consider(middle);
+    double plane_distance{point[split_axes[middle]] - points[middle][split_axes[middle]]};
+    if(plane_distance <= 0 || plane_distance * plane_distance <= radius_squared){
+        search_within(point, begin, middle, radius_squared, excluded_id, found);
+    }
+    if(plane_distance >= 0 || plane_distance * plane_distance <= radius_squared){
+        search_within(point, middle + 1, end, radius_squared, excluded_id, found);
+    }
+}
+
+bool celestial_objects::numerical_sort(int& a, int& b)
+{
+    return a < b;
+}
+
+bool celestial_objects::numerical_sort(double& a, double& b)
+{
+    return a < b;
+}
+
+bool celestial_objects::hubble_sort(celestial_objects::hubble_types& hubtype_a, celestial_objects::hubble_types& hubtype_b)
+{
+    int a{int(hubtype_a)};
+    int b{int(hubtype_b)};
+    return a < b;
+}
+
+bool celestial_objects::stellar_sort(celestial_objects::stellar_types& steltype_a, celestial_objects::stellar_types& steltype_b)
+{
+    int a{int(steltype_a)};
+    int b{int(steltype_b)};
+    return a < b;
+}
+
+void* celestial_objects::object_arena::allocate(std::size_t size, std::size_t alignment)
+{
+    /* Returns a block of at least size bytes with the given alignment, taken from the current slab where it fits. Otherwise a new
+    slab is started, which is made larger than arena_slab_size for any single request too big for a normal slab. */
+    void* block{slab_position};
+    if(slab_position == nullptr || std::align(alignment, size, block, slab_remaining) == nullptr){
+        std::size_t new_slab_size{std::max(arena_slab_size, size + alignment)};
+        //The slab is left uninitialised, as every object is constructed over its memory
+        slabs.push_back(std::unique_ptr<char[]>(new char[new_slab_size]));
+        block = slabs.back().get();
+        slab_remaining = new_slab_size;
+        if(std::align(alignment, size, block, slab_remaining) == nullptr){
+            throw std::bad_alloc();
+        }
+    }
+    slab_position = static_cast<char*>(block) + size;
+    slab_remaining -= size;
+    return block;
+}
+
+celestial_objects::export_buffer& celestial_objects::export_buffer::operator<<(double value)
+{
+    //A default std::ostream writes doubles as printf's %g does, with 6 significant figures, which std::to_chars can reproduce exactly
+    char digits[32];
+    std::to_chars_result result{std::to_chars(digits, digits + sizeof(digits), value, std::chars_format::general, 6)};
+    buffer.append(digits, result.ptr);
+    return check_size();
+}
+
+celestial_objects::export_buffer& celestial_objects::export_buffer::operator<<(int value)
+{
+    char digits[16];
+    std::to_chars_result result{std::to_chars(digits, digits + sizeof(digits), value)};
+    buffer.append(digits, result.ptr);
+    return check_size();
+}
+
+void celestial_objects::export_buffer::flush()
+{
+    //Writes out everything collected so far, keeping the buffer's memory for the next block
+    if(destination != nullptr && !buffer.empty()){
+        destination->write(buffer.data(), std::streamsize(buffer.size()));
+        buffer.clear();
+    }
+}
+
+bool celestial_objects::mapped_file::open(const std::string& path)
+{
+    /* Opens the file at the given path for reading, returning false if it cannot be opened. Any previously opened file is
+    released first. An empty file is valid and gives empty contents. */
+    close();
+#if defined(__unix__) || defined(__APPLE__)
+    int descriptor{::open(path.c_str(), O_RDONLY)};
+    if(descriptor == -1){
+        return false;
+    }
+    struct stat file_status;
+    if(::fstat(descriptor, &file_status) == -1 || !S_ISREG(file_status.st_mode)){
+        ::close(descriptor);
+        return false;
+    }
+    file_size = std::size_t(file_status.st_size);
+    if(file_size > 0){
+        void* mapping{::mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, descriptor, 0)};
+        if(mapping == MAP_FAILED){
+            ::close(descriptor);
+            file_size = 0;
+            return false;
+        }
+        //The files are always parsed from start to end, so the kernel can read ahead aggressively
+        ::madvise(mapping, file_size, MADV_SEQUENTIAL);
+        file_data = static_cast<const char*>(mapping);
+        mapped = true;
+    }
+    //The mapping stays valid once the descriptor has been closed
+    ::close(descriptor);
+#else
+    std::ifstream input(path, std::ios::in | std::ios::binary);
+    if(!input.good() || std::filesystem::is_directory(path)){
+        return false;
+    }
+    file_buffer.resize(std::size_t(std::filesystem::file_size(path)));
+    input.read(file_buffer.data(), std::streamsize(file_buffer.size()));
+    file_size = std::size_t(input.gcount());
+    file_data = file_buffer.data();
+#endif
+    opened = true;
+    return true;
+}
+
+void celestial_objects::mapped_file::close()
+{
+#if defined(__unix__) || defined(__APPLE__)
+    if(mapped){
+        ::munmap(const_cast<char*>(file_data), file_size);
+    }
+#endif
+    file_buffer.clear();
+    file_buffer.shrink_to_fit();
+    file_data = nullptr;
+    file_size = 0;
+    mapped = false;
+    opened = false;
+}
+
+bool celestial_objects::operation_log::open(const std::string& path)
+{
+    /* Opens the log at the given path for appending, creating it if needed, and starts the writer thread. Returns false if the
+    file cannot be opened, or if another log holds it, in which case is_in_use() is true. Any previously opened log is closed first. */
+    close();
+    in_use = false;
+    log_file = std::fopen(path.c_str(), "ab");
+    if(log_file == nullptr){
+        return false;
+    }
+#if defined(__unix__) || defined(__APPLE__)
+    //The lock belongs to this open file, so it is held until the file is closed, even against other logs in the same process
+    if(::flock(::fileno(log_file), LOCK_EX | LOCK_NB) != 0){
+        in_use = errno == EWOULDBLOCK;
+        std::fclose(log_file);
+        log_file = nullptr;
+        return false;
+    }
+#endif
+    log_path = path;
+    pending.clear();
+    appended_sequence = 0;
+    committed_sequence = 0;
+    stopping = false;
+    failed = false;
+    writer = std::thread(&operation_log::write_pending, this);
+    return true;
+}
+
+void celestial_objects::operation_log::close()
+{
+    //Commits every pending record before the writer thread is stopped and the file is closed
+    if(log_file == nullptr){
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(log_mutex);
+        stopping = true;
+    }
+    log_condition.notify_all();
+    writer.join();
+    std::fclose(log_file);
+    log_file = nullptr;
+}
+
+bool celestial_objects::operation_log::append(std::string_view record)
+{
+    /* Adds the record to the pending buffer and waits until the writer thread has synced the batch carrying it. Returns false if
+    that batch, or any before it, could not be written, as the log can then no longer be relied upon to recover every change. */
+    if(log_file == nullptr){
+        return false;
+    }
+    std::unique_lock<std::mutex> lock(log_mutex);
+    pending.append(record);
+    std::uint64_t sequence{++appended_sequence};
+    log_condition.notify_one();
+    commit_condition.wait(lock, [&]{return committed_sequence >= sequence;});
+    return !failed;
+}
+
+bool celestial_objects::operation_log::truncate(std::size_t size)
+{
+    //Cuts the log back to the given size, keeping it open and locked. Each append waits for its record to be committed, so no
+    //records are pending when the log's owner calls this
+    if(log_file == nullptr){
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(log_mutex);
+    if(std::fflush(log_file) != 0){
+        return false;
+    }
+#if defined(__unix__) || defined(__APPLE__)
+    return ::ftruncate(::fileno(log_file), off_t(size)) == 0;
+#else
+    std::error_code error;
+    std::filesystem::resize_file(log_path, size, error);
+    return !error;
+#endif
+}
+
+void celestial_objects::operation_log::write_pending()
+{
+    /* Runs on the writer thread, taking the whole pending buffer each time it is woken and writing and syncing it as one batch.
+    Records appended while a batch is being synced are left for the next batch, which commits them all together. Once a batch
+    has been synced, every append waiting on a record within it is woken. */
+    std::string batch;
+    std::unique_lock<std::mutex> lock(log_mutex);
+    while(true){
+        log_condition.wait(lock, [this]{return stopping || !pending.empty();});
+        if(pending.empty()){
+            break;
+        }
+        batch.swap(pending);
+        std::uint64_t batch_sequence{appended_sequence};
+        lock.unlock();
+        bool written{std::fwrite(batch.data(), 1, batch.size(), log_file) == batch.size() && std::fflush(log_file) == 0};
+#if defined(__unix__) || defined(__APPLE__)
+        written = written && ::fsync(::fileno(log_file)) == 0;
+#endif
+        batch.clear();
+        lock.lock();
+        failed = failed || !written;
+        committed_sequence = batch_sequence;
+        commit_condition.notify_all();
+    }
+}
+
+bool celestial_objects::is_stellar_type(celestial_types type)
+{
+    //True for star and every class derived from it, which share the stellar parameters in the catalogue files
+    if(int(type) < 0 || int(type) >= celestial_type_number){
+        return false;
+    }
+    return (type_ancestry[int(type)] & type_bit(celestial_types::Star)) != 0;
+}
+
+std::string celestial_objects::timestamp_string()
+{
+    //Timestamps help fix the issue of creating a unique file name when exporting without overwriting the base files.
+    std::time_t current{std::time(nullptr)};
+    std::tm now{*std::localtime(&current)};
+    std::stringstream timestamp;
+    timestamp << now.tm_yday << now.tm_mon << now.tm_year << "_" << now.tm_hour << now.tm_min << now.tm_sec;
+    return timestamp.str();
+}
+
+std::string celestial_objects::operation_log_file_name(const std::string& object_file_name)
+{
+    //The operation log sits alongside the object file, with its '.dat' or '.ccat' extension replaced by '.wal'
+    std::string file_name{object_file_name};
+    if(file_name.size() >= 4 && file_name.compare(file_name.size() - 4, 4, ".dat") == 0){
+        file_name.erase(file_name.size() - 4);
+    } else if(file_name.size() >= 5 && file_name.compare(file_name.size() - 5, 5, ".ccat") == 0){
+        file_name.erase(file_name.size() - 5);
+    }
+    return file_name + ".wal";
+}
+
+int celestial_objects::delta_sequence(std::string_view file_text)
+{
+    //Gives the highest number on the '#delta:' markers in some text from a .dat file, or 0 if none are numbered
+    int sequence{0};
+    std::string_view line;
+    while(next_line(file_text, line)){
+        if(line.substr(0, 7) == "#delta:"){
+            try{
+                sequence = std::max(sequence, parse_int(line.substr(7)));
+            } catch(std::invalid_argument const& exception){
+                std::cout << "ERROR: " << exception.what() << std::endl;
+            }
+        }
+    }
+    return sequence;
+}
+
+std::string celestial_objects::relationship_file_name(const std::string& object_file_name)
+{
+    //The relationship file sits alongside the object file, with '_relationships' inserted before the '.dat' extension if there is one
+    std::string file_name{object_file_name};
+    std::size_t insertion_position{file_name.rfind(".dat")};
+    if(insertion_position == std::string::npos){
+        insertion_position = file_name.length();
+    }
+    file_name.insert(insertion_position, "_relationships");
+    return file_name;
+}
+
+void celestial_objects::write_binary_column(std::ofstream& file, const void* data, std::size_t bytes)
+{
+    //Pads every column to a multiple of 8 bytes so that each column starts on an aligned offset in the file
+    constexpr char padding[8]{};
+    file.write(static_cast<const char*>(data), std::streamsize(bytes));
+    file.write(padding, std::streamsize(((bytes + 7) & ~std::size_t(7)) - bytes));
+}
+
+int celestial_objects::choose_worker_count(std::size_t work_size, std::size_t minimum_work_per_worker)
+{
+    /* Gives the number of threads to split a piece of work across, using every available core up to max_worker_threads
+    whilst making sure that each thread has at least the minimum amount of work, so small jobs stay on one thread. */
+    int hardware_threads{int(std::thread::hardware_concurrency())};
+    if(hardware_threads < 1){
+        hardware_threads = 1;
+    }
+    std::size_t useful_threads{std::max<std::size_t>(1, work_size / std::max<std::size_t>(1, minimum_work_per_worker))};
+    return int(std::min<std::size_t>(useful_threads, std::size_t(std::min(hardware_threads, max_worker_threads))));
+}
+
+std::uint64_t celestial_objects::name_prefix_key(const std::string& sort_key)
+{
+    //Packs the first 8 bytes of a key into an integer which orders the same way as the strings, padding short keys with zeroes
+    std::uint64_t prefix{0};
+    for(std::size_t i{0}; i < 8; i++){
+        prefix <<= 8;
+        if(i < sort_key.size()){
+            prefix |= std::uint64_t((unsigned char)sort_key[i]);
+        }
+    }
+    return prefix;
+}
+
+std::uint64_t celestial_objects::radix_key(double value)
+{
+    /* Maps a double onto an unsigned integer with the same ordering, so that it can be radix sorted. Positive values have their
+    sign bit set, and negative values have every bit flipped so that larger magnitudes come first. */
+    if(value == 0){
+        //Negative zero compares equal to zero, so is given the same key
+        value = 0;
+    }
+    std::uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return (bits & (std::uint64_t{1} << 63)) ? ~bits : (bits | (std::uint64_t{1} << 63));
+}
+
+std::uint64_t celestial_objects::radix_key(int value)
+{
+    //Flipping the sign bit places negative values below positive ones
+    return std::uint64_t(std::uint32_t(value) ^ (std::uint32_t{1} << 31));
+}
+
+void celestial_objects::radix_sort(std::vector<std::uint64_t>& keys, std::vector<int>& items)
+{
+    /* Stable least significant digit radix sort of items by their keys, a byte at a time. Keys and items are moved together,
+    and any byte which is the same for every key is skipped, so narrow keys only take as many passes as they need. */
+    std::size_t n{items.size()};
+    std::vector<std::uint64_t> sorted_keys(n);
+    std::vector<int> sorted_items(n);
+    for(int shift{0}; shift < 64; shift += 8){
+        std::array<std::size_t, 257> offsets{};
+        for(std::uint64_t key : keys){
+            offsets[((key >> shift) & 0xFF) + 1]++;
+        }
+        if(n == 0 || offsets[((keys[0] >> shift) & 0xFF) + 1] == n){
+            continue;
+        }
+        for(int digit{0}; digit < 256; digit++){
+            offsets[digit + 1] += offsets[digit];
+        }
+        for(std::size_t i{0}; i < n; i++){
+            std::size_t destination{offsets[(keys[i] >> shift) & 0xFF]++};
+            sorted_keys[destination] = keys[i];
+            sorted_items[destination] = items[i];
+        }
+        keys.swap(sorted_keys);
+        items.swap(sorted_items);
+    }
+}
+
+void celestial_objects::counting_sort(const std::vector<int>& keys, int minimum_key, int maximum_key, std::vector<int>& items)
+{
+    /* Stable counting sort of items, where keys[i] is the key of items[i] and every key lies within [minimum_key, maximum_key]. */
+    std::vector<std::size_t> offsets(std::size_t(std::int64_t(maximum_key) - minimum_key) + 2, 0);
+    for(int key : keys){
+        offsets[std::size_t(std::int64_t(key) - minimum_key) + 1]++;
+    }
+    for(std::size_t i{1}; i < offsets.size(); i++){
+        offsets[i] += offsets[i - 1];
+    }
+    std::vector<int> sorted_items(items.size());
+    for(std::size_t i{0}; i < items.size(); i++){
+        sorted_items[offsets[std::size_t(std::int64_t(keys[i]) - minimum_key)]++] = items[i];
+    }
+    items.swap(sorted_items);
+}
+
+std::uint32_t celestial_objects::nested_pixel(std::uint32_t row, std::uint32_t column, int level)
+{
+    /* Numbers a pixel of the sky grid at the given level so that the pixels nest. The grid is made of two square faces, one for each
+    half of the sky in right ascension, and within a face the bits of the row and column are interleaved. Each pixel then contains
+    the four pixels at the next level numbered 4p to 4p + 3, so every pixel at a coarser level covers a contiguous range of finer pixels. */
+    std::uint32_t face{column >> level};
+    std::uint32_t face_column{column & ((std::uint32_t{1} << level) - 1)};
+    std::uint32_t pixel{0};
+    for(int bit{0}; bit < level; bit++){
+        pixel |= ((face_column >> bit) & 1) << (2 * bit);
+        pixel |= ((row >> bit) & 1) << (2 * bit + 1);
+    }
+    return (face << (2 * level)) | pixel;
+}
+
+std::uint32_t celestial_objects::sky_pixel(double right_ascension, double declination, int level)
+{
+    /* Gives the pixel containing a sky position at the given level. Rows are evenly spaced in the sine of the declination and columns
+    in right ascension, which is a cylindrical equal-area projection, so every pixel at a level covers the same area of sky. */
+    std::uint32_t rows{std::uint32_t{1} << level};
+    std::uint32_t columns{2 * rows};
+    double row{std::floor((std::sin(declination * degrees_to_radians) + 1) / 2 * rows)};
+    double column{std::floor(right_ascension / 360 * columns)};
+    return nested_pixel(std::uint32_t(std::min(double(rows - 1), std::max(0.0, row))),
+    std::uint32_t(std::min(double(columns - 1), std::max(0.0, column))), level);
+}
+
+bool celestial_objects::valid_sky_position(double right_ascension, double declination)
+{
+    //Written so that NaN coordinates are rejected as well
+    return right_ascension >= 0 && right_ascension < 360 && declination >= -90 && declination <= 90;
+}
+
+bool celestial_objects::next_line(std::string_view& text, std::string_view& line)
+{
+    /* Removes the first line from text and places it in line, returning false once there is no text left.
+    Trailing carriage returns are removed so that files written on Windows are read identically. */
+    if(text.empty()){
+        return false;
+    }
+    std::size_t line_end{text.find('\n')};
+    if(line_end == std::string_view::npos){
+        line = text;
+        text = std::string_view{};
+    } else{
+        line = text.substr(0, line_end);
+        text.remove_prefix(line_end + 1);
+    }
+    if(!line.empty() && line.back() == '\r'){
+        line.remove_suffix(1);
+    }
+    return true;
+}
+
+std::size_t celestial_objects::split_fields(std::string_view line, std::array<std::string_view, max_line_fields>& fields)
+{
+    /* Splits a line at each ':' into views over the line, returning the number of fields found.
+    Replaces the old find/substr/erase loop, which copied the remainder of the line for every field. */
+    std::size_t field_number{0};
+    while(field_number < max_line_fields){
+        std::size_t break_point{line.find(':')};
+        fields[field_number] = line.substr(0, break_point);
+        field_number++;
+        if(break_point == std::string_view::npos){
+            break;
+        }
+        line.remove_prefix(break_point + 1);
+    }
+    return field_number;
+}
+
+double celestial_objects::parse_double(std::string_view field)
+{
+    //std::from_chars does not allocate or depend on the locale, but unlike std::stod it does not skip a leading '+'
+    if(!field.empty() && field.front() == '+'){
+        field.remove_prefix(1);
+    }
+    double value{0};
+    std::from_chars_result result{std::from_chars(field.data(), field.data() + field.size(), value)};
+    if(result.ec != std::errc() || result.ptr != field.data() + field.size()){
+        throw std::invalid_argument("Invalid numeric value '" + std::string(field) + "'.");
+    }
+    return value;
+}
+
+int celestial_objects::parse_int(std::string_view field)
+{
+    if(!field.empty() && field.front() == '+'){
+        field.remove_prefix(1);
+    }
+    int value{0};
+    std::from_chars_result result{std::from_chars(field.data(), field.data() + field.size(), value)};
+    if(result.ec != std::errc() || result.ptr != field.data() + field.size()){
+        throw std::invalid_argument("Invalid integer value '" + std::string(field) + "'.");
+    }
+    return value;
+}
+
+int celestial_objects::find_output_position(const std::vector<std::string>& outputs, std::string_view field)
+{
+    /* Gives the position of field within one of the enum output vectors, or the size of the vector if it is not present,
+    matching the behaviour of the std::find calls used elsewhere. */
+    for(std::size_t i{0}; i < outputs.size(); i++){
+        if(outputs[i] == field){
+            return int(i);
+        }
+    }
+    return int(outputs.size());
+}
+
+int celestial_objects::parse_output_field(const std::vector<std::string>& outputs, std::string_view field, const char* field_name)
+{
+    //Gives the position of field within one of the enum output vectors, throwing std::invalid_argument if it is not one of them
+    int position{find_output_position(outputs, field)};
+    if(position == int(outputs.size())){
+        throw std::invalid_argument("Invalid " + std::string(field_name) + " '" + std::string(field) + "'.");
+    }
+    return position;
 }
\ No newline at end of file
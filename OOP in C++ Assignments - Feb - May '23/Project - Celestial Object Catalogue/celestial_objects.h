@@ -29,9 +29,23 @@
 #include <iostream>
 #include <memory>
 #include <fstream>
+#include <unordered_map>
 #include <filesystem>
 #include <algorithm>
 #include <ctime>
+#include <array>
+#include <string_view>
+#include <charconv>
+#include <stdexcept>
+#include <thread>
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#include <numeric>
+#include <cmath>
+#include <cstdio>
+#include <mutex>
+#include <condition_variable>
 
 namespace celestial_objects
 {   
@@ -54,6 +68,35 @@ namespace celestial_objects
     const std::vector<std::string> celestial_types_output{"Unassigned", "Galaxy", "Star", "MainSequenceStar", "RedGiantStar", 
                                                     "Planet", "TerrestrialPlanet", "GaseousPlanet", "Dwarf Planet", "Moon", "Comet", "Asteroid", "Satellite",
                                                     "StellarRemnant", "Supernova", "NeutronStar", "Pulsar", "BlackHole"};
+    constexpr int celestial_type_number{18};
+
+    //Sets of object types are held as bitmasks, with one bit per celestial_types value
+    using type_mask = std::uint32_t;
+    constexpr type_mask type_bit(celestial_types type){return type_mask{1} << int(type);}
+
+    //The class each type is derived from, where Unassigned stands for the celestial_object base class
+    constexpr std::array<celestial_types, celestial_type_number> type_parents{celestial_types::Unassigned, celestial_types::Unassigned,
+    celestial_types::Unassigned, celestial_types::Star, celestial_types::Star, celestial_types::Unassigned, celestial_types::Planet,
+    celestial_types::Planet, celestial_types::Planet, celestial_types::Unassigned, celestial_types::Unassigned, celestial_types::Unassigned,
+    celestial_types::Unassigned, celestial_types::Star, celestial_types::StellarRemnant, celestial_types::StellarRemnant,
+    celestial_types::NeutronStar, celestial_types::Unassigned};
+
+    constexpr std::array<type_mask, celestial_type_number> make_type_ancestry()
+    {
+        //Walks up the class hierarchy from each type, so that each mask holds the type itself and every class it derives from
+        std::array<type_mask, celestial_type_number> ancestry{};
+        for(int i{0}; i < celestial_type_number; i++){
+            celestial_types type{celestial_types(i)};
+            ancestry[i] = type_bit(type);
+            while(type != celestial_types::Unassigned){
+                type = type_parents[int(type)];
+                ancestry[i] |= type_bit(type);
+            }
+        }
+        return ancestry;
+    }
+    //An object matches a requested set of types if any of the types it derives from was requested
+    constexpr std::array<type_mask, celestial_type_number> type_ancestry{make_type_ancestry()};
 
     //Enum class for hubble types of galaxies
     //This was taken from the previous galaxies assignment, if it ain't broke, don't fix it.
@@ -67,16 +110,24 @@ namespace celestial_objects
 
     //Enum class for luminosity class of stellar objects
     enum class luminosity_class{Unassigned, Zero, IaPlus, Ia, Iab, Ib, II, III, IV, V, VI, VII};
-    const std::vector<std::string> luminosity_class_output{"Unassigned", "0", "Ia+", "Iab", "Ib", "II", "III", "IV",
+    const std::vector<std::string> luminosity_class_output{"Unassigned", "0", "Ia+", "Ia", "Iab", "Ib", "II", "III", "IV",
                                                      "V", "VI", "VII"};
 
-    enum class parameters{Name, CelestialType, HubbleType, StellarType, Redshift, Distance, Mass, RotationalVelocity, MemberNumber};
-    const std::vector<std::string> parameters_output{"Name", "CelestialType", "HubbleType", "StellarType", "Redshift", "Mass", "RotationalVelocity", "MemberNumber"};
+    enum class parameters{Name, CelestialType, HubbleType, StellarType, Redshift, Distance, Mass, RotationalVelocity, RightAscension, Declination,
+    MemberNumber};
+    const std::vector<std::string> parameters_output{"Name", "CelestialType", "HubbleType", "StellarType", "Redshift", "Distance", "Mass", "RotationalVelocity",
+                                               "RightAscension", "Declination", "MemberNumber"};
+    constexpr int parameter_number{11};
+
+    //Modes of catalogue::generate_report(), for the whole report, only its summary, or the whole report a page at a time
+    enum class report_modes{Full, Summary, Paged};
+    const std::vector<std::string> report_modes_output{"full", "summary", "paged"};
     class celestial_object;
     class satellite;
     class catalogue;
+    class export_buffer;
 
-    class celestial_object
+    class celestial_object : public std::enable_shared_from_this<celestial_object>
     {
         /* Acts as an abstract class for all celestial objects e.g. stars, galaxies, etc. The key data is included in
         this class, being: name, object type, redshift, distance, mass, rotational velocity and a vector orbiting objects, as these can apply to
@@ -89,9 +140,11 @@ namespace celestial_objects
             double distance{0};
             double mass{0};
             double rotational_velocity{0};
-            //double right_ascension{0};
-            //double declination{};
-            //Vector for orbiting/bound objects
+            //Equatorial coordinates of the object on the sky, in degrees
+            double right_ascension{0};
+            double declination{0};
+            //Vector for orbiting/bound objects, used by objects outside of a catalogue
+            //Objects in a catalogue are linked through its own hierarchy store instead, and only their member count is kept here
             std::weak_ptr<celestial_object> parent_object;
             std::vector<celestial_objects::satellite> member_objects;
             int member_number{0};
@@ -129,6 +182,32 @@ namespace celestial_objects
                     std::cout<< std::endl;
                 }
 
+                std::cin.clear();
+                std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+                std::cout << "Enter the object's right ascension (in degrees, from 0 up to 360): ";
+                std::cin >> right_ascension;
+                std::cout<< std::endl;
+                while(std::cin.fail() || (right_ascension < 0 || right_ascension >= 360)){
+                    std::cin.clear();
+                    std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+                    std::cout << "Please enter a valid right ascension: ";
+                    std::cin >> right_ascension;
+                    std::cout<< std::endl;
+                }
+
+                std::cin.clear();
+                std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+                std::cout << "Enter the object's declination (in degrees, between -90 and 90): ";
+                std::cin >> declination;
+                std::cout<< std::endl;
+                while(std::cin.fail() || (declination < -90 || declination > 90)){
+                    std::cin.clear();
+                    std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+                    std::cout << "Please enter a valid declination: ";
+                    std::cin >> declination;
+                    std::cout<< std::endl;
+                }
+
                 std::cin.clear();
                 std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
                 std::cout << "Enter the object's mass (in solar masses): ";
@@ -161,7 +240,7 @@ namespace celestial_objects
             //Most constructors are defined here as many of the classes share similar parameters, hence constructing from base class reference is very useful 
             celestial_object(std::string name_input, double z, double dist, double m, double omega)
             {
-                name = name_input;
+                name = std::move(name_input);
                 redshift = z;
                 distance = dist;
                 mass = m;
@@ -169,7 +248,7 @@ namespace celestial_objects
             }
 
             //Copy constructor and assignment operator
-            celestial_object(const celestial_object& object)
+            celestial_object(const celestial_object& object):std::enable_shared_from_this<celestial_object>()
             {
                 this->object_type = object.object_type;
                 this->name = object.name;
@@ -177,6 +256,8 @@ namespace celestial_objects
                 this->distance = object.distance;
                 this->mass = object.mass;
                 this->rotational_velocity = object.rotational_velocity;
+                this->right_ascension = object.right_ascension;
+                this->declination = object.declination;
                 this->member_objects = object.member_objects;
                 this->member_number = object.member_number;
             }
@@ -192,6 +273,8 @@ namespace celestial_objects
                     this->distance = object.distance;
                     this->mass = object.mass;
                     this->rotational_velocity = object.rotational_velocity;
+                    this->right_ascension = object.right_ascension;
+                    this->declination = object.declination;
                     this->member_objects = object.member_objects;
                     this->member_number = object.member_number;
                     return *this;
@@ -207,6 +290,8 @@ namespace celestial_objects
                 std::swap(this->distance, object.distance);
                 std::swap(this->mass, object.mass);
                 std::swap(this->rotational_velocity, object.rotational_velocity);
+                std::swap(this->right_ascension, object.right_ascension);
+                std::swap(this->declination, object.declination);
                 std::swap(this->member_objects, object.member_objects);
                 std::swap(this->member_number, object.member_number);
             }
@@ -219,6 +304,8 @@ namespace celestial_objects
                 std::swap(this->distance, object.distance);
                 std::swap(this->mass, object.mass);
                 std::swap(this->rotational_velocity, object.rotational_velocity);
+                std::swap(this->right_ascension, object.right_ascension);
+                std::swap(this->declination, object.declination);
                 std::swap(this->member_objects, object.member_objects);
                 std::swap(this->member_number, object.member_number);
                 return *this;
@@ -230,18 +317,25 @@ namespace celestial_objects
 
             void add_member(std::shared_ptr<celestial_object> member_ptr);
             void add_member(std::shared_ptr<celestial_object> member_ptr, double orb_distance, double orb_tilt, double orb_eccentricity);
+            bool has_ancestor(const celestial_object* object) const;
             //void remove_member();
             //void remove_member(int& index);
-            virtual void export_to_file(std::fstream& object_dat, std::fstream& relation_dat);
+            virtual void export_to_file(export_buffer& object_data, export_buffer& relation_data);
+            void export_relationships(export_buffer& relation_data);
+            void export_relationship(export_buffer& relation_data, int index);
             celestial_objects::satellite get_member(int& index);
-            std::string get_name()const{return name;}
+            const std::string& get_name()const{return name;}
             void get_properties();
+            void get_object_properties();
+            void write_properties(export_buffer& report_data);
             celestial_objects::celestial_types get_type(){return object_type;}
             int get_member_number(){return member_number;}
+            double get_right_ascension()const{return right_ascension;}
+            double get_declination()const{return declination;}
     
-            //Allows for specific properties to be returned to the console, but must be overridden in derived classes.
+            //Allows for specific properties to be written out with the rest, but must be overridden in derived classes.
             //This also represents a convenient function to set as purely virtual, hence making this class abstract.
-            virtual void get_additional_properties() = 0;
+            virtual void write_additional_properties(export_buffer& report_data) = 0;
             std::vector<satellite> get_all_members();
 
             //Allows the import process to directly access these objects when parsing data
@@ -319,6 +413,8 @@ namespace celestial_objects
                     this->distance = g.distance;
                     this->mass = g.mass;
                     this->rotational_velocity = g.rotational_velocity;
+                    this->right_ascension = g.right_ascension;
+                    this->declination = g.declination;
                     this->member_objects = g.member_objects;
                     this->member_number = g.member_number;
                     this->stellar_mass_fraction = g.stellar_mass_fraction;
@@ -342,6 +438,8 @@ namespace celestial_objects
                 std::swap(this->distance, g.distance);
                 std::swap(this->mass, g.mass);
                 std::swap(this->rotational_velocity, g.rotational_velocity);
+                std::swap(this->right_ascension, g.right_ascension);
+                std::swap(this->declination, g.declination);
                 std::swap(this->member_objects, g.member_objects);
                 std::swap(this->member_number, g.member_number);
                 std::swap(this->stellar_mass_fraction, g.stellar_mass_fraction);
@@ -350,15 +448,17 @@ namespace celestial_objects
             }
 
             galaxy(std::string name_input, double z, double dist, double m, double omega, double mass_frac, hubble_types h_type):
-            celestial_object(name_input, z, dist, m, omega)
+            celestial_object(std::move(name_input), z, dist, m, omega)
             {
                 object_type = celestial_types::Galaxy;
                 stellar_mass_fraction = mass_frac;
                 hubble_type = h_type;
             }
 
-            void export_to_file(std::fstream& object_dat, std::fstream& relation_dat);
-            virtual void get_additional_properties() override;
+            void export_to_file(export_buffer& object_data, export_buffer& relation_data) override;
+            virtual void write_additional_properties(export_buffer& report_data) override;
+            //Allows the catalogue to read the galaxy parameters directly when writing binary catalogues
+            friend class catalogue;
     };
 
     class star : public celestial_object
@@ -434,6 +534,8 @@ namespace celestial_objects
                     this->distance = s.distance;
                     this->mass = s.mass;
                     this->rotational_velocity = s.rotational_velocity;
+                    this->right_ascension = s.right_ascension;
+                    this->declination = s.declination;
                     this->member_objects = s.member_objects;
                     this->member_number = s.member_number;
                     this->star_type = s.star_type;
@@ -463,6 +565,8 @@ namespace celestial_objects
                 std::swap(this->distance, s.distance);
                 std::swap(this->mass, s.mass);
                 std::swap(this->rotational_velocity, s.rotational_velocity);
+                std::swap(this->right_ascension, s.right_ascension);
+                std::swap(this->declination, s.declination);
                 std::swap(this->member_objects, s.member_objects);
                 std::swap(this->member_number, s.member_number);
                 std::swap(this->star_type, s.star_type);
@@ -474,7 +578,7 @@ namespace celestial_objects
             }
 
             star(std::string name_input, double z, double dist, double m, double omega, stellar_types s_type,
-            int s_digit, luminosity_class lum_no, double abs_mag, double app_mag):celestial_object(name_input, z,
+            int s_digit, luminosity_class lum_no, double abs_mag, double app_mag):celestial_object(std::move(name_input), z,
             dist, m, omega)
             {
                 object_type = celestial_types::Star;
@@ -485,8 +589,10 @@ namespace celestial_objects
                 app_magnitude = app_mag;
             }
 
-            void export_to_file(std::fstream& object_dat, std::fstream& relation_dat);
-            virtual void get_additional_properties() override;
+            void export_to_file(export_buffer& object_data, export_buffer& relation_data) override;
+            virtual void write_additional_properties(export_buffer& report_data) override;
+            //Allows the catalogue to read the stellar parameters directly when writing binary catalogues
+            friend class catalogue;
     };
 
     class main_sequence_star : public star
@@ -503,7 +609,7 @@ namespace celestial_objects
             main_sequence_star(main_sequence_star&& msstar):star(msstar){object_type = celestial_types::MainSequenceStar;}
 
             main_sequence_star(std::string name_input, double z, double dist, double m, double omega, stellar_types s_type,
-            int s_digit, luminosity_class lum_no, double abs_mag, double app_mag):star(name_input, z, dist, m, omega, 
+            int s_digit, luminosity_class lum_no, double abs_mag, double app_mag):star(std::move(name_input), z, dist, m, omega, 
             s_type, s_digit, lum_no, abs_mag, app_mag)
             {
                 object_type = celestial_types::MainSequenceStar;
@@ -525,7 +631,7 @@ namespace celestial_objects
             red_giant_star(red_giant_star&& rgstar):star(rgstar){object_type = celestial_types::RedGiantStar;};
 
             red_giant_star(std::string name_input, double z, double dist, double m, double omega, stellar_types s_type,
-            int s_digit, luminosity_class lum_no, double abs_mag, double app_mag):star(name_input, z, dist, m, omega, 
+            int s_digit, luminosity_class lum_no, double abs_mag, double app_mag):star(std::move(name_input), z, dist, m, omega, 
             s_type, s_digit, lum_no, abs_mag, app_mag)
             {
                 object_type = celestial_types::RedGiantStar;
@@ -547,15 +653,12 @@ namespace celestial_objects
             planet(const planet& plan):celestial_object(plan){object_type = celestial_types::Planet;};
             planet(planet&& plan):celestial_object(plan){object_type = celestial_types::Planet;};
 
-            planet(std::string name_input, double z, double dist, double m, double omega):celestial_object(name_input, z, dist, m, omega)
+            planet(std::string name_input, double z, double dist, double m, double omega):celestial_object(std::move(name_input), z, dist, m, omega)
             {
                 object_type = celestial_types::Planet;
             }
 
-            virtual void get_additional_properties() override
-            {
-                std::cout << "No additional properties. " << std::endl;
-            }
+            virtual void write_additional_properties(export_buffer& report_data) override;
     };
 
     class terrestrial_planet : public planet
@@ -571,7 +674,7 @@ namespace celestial_objects
             terrestrial_planet(const terrestrial_planet& t_plan):planet(t_plan){object_type = celestial_types::TerrestrialPlanet;};
             terrestrial_planet(terrestrial_planet&& t_plan):planet(t_plan){object_type = celestial_types::TerrestrialPlanet;};
 
-            terrestrial_planet(std::string name_input, double z, double dist, double m, double omega):planet(name_input, z, dist, m, omega)
+            terrestrial_planet(std::string name_input, double z, double dist, double m, double omega):planet(std::move(name_input), z, dist, m, omega)
             {
                 object_type = celestial_types::TerrestrialPlanet;
             }
@@ -590,7 +693,7 @@ namespace celestial_objects
             gaseous_planet(const gaseous_planet& t_plan):planet(t_plan){object_type = celestial_types::GaseousPlanet;}
             gaseous_planet(gaseous_planet&& t_plan):planet(t_plan){object_type = celestial_types::GaseousPlanet;}
 
-            gaseous_planet(std::string name_input, double z, double dist, double m, double omega):planet(name_input, z, dist, m, omega)
+            gaseous_planet(std::string name_input, double z, double dist, double m, double omega):planet(std::move(name_input), z, dist, m, omega)
             {
                 object_type = celestial_types::GaseousPlanet;
             }
@@ -609,7 +712,7 @@ namespace celestial_objects
             dwarf_planet(const dwarf_planet& d_plan):planet(d_plan){object_type = celestial_types::DwarfPlanet;}
             dwarf_planet(dwarf_planet&& d_plan):planet(d_plan){object_type = celestial_types::DwarfPlanet;}
 
-            dwarf_planet(std::string name_input, double z, double dist, double m, double omega):planet(name_input, z, dist, m, omega)
+            dwarf_planet(std::string name_input, double z, double dist, double m, double omega):planet(std::move(name_input), z, dist, m, omega)
             {
                 object_type = celestial_types::DwarfPlanet;
             }
@@ -628,15 +731,12 @@ namespace celestial_objects
             moon(const moon& m):celestial_object(m){object_type = celestial_types::Moon;}
             moon(moon&& m):celestial_object(m){object_type = celestial_types::Moon;}
 
-            moon(std::string name_input, double z, double dist, double m, double omega):celestial_object(name_input, z, dist, m, omega)
+            moon(std::string name_input, double z, double dist, double m, double omega):celestial_object(std::move(name_input), z, dist, m, omega)
             {
                 object_type = celestial_types::Moon;
             }
 
-            virtual void get_additional_properties() override
-            {
-                std::cout << "No additional properties. " << std::endl;
-            }
+            virtual void write_additional_properties(export_buffer& report_data) override;
     };
 
     class comet : public celestial_object
@@ -652,15 +752,12 @@ namespace celestial_objects
             comet(const comet& c):celestial_object(c){object_type = celestial_types::Comet;}
             comet(comet&& c):celestial_object(c){object_type = celestial_types::Comet;}
 
-            comet(std::string name_input, double z, double dist, double m, double omega):celestial_object(name_input, z, dist, m, omega)
+            comet(std::string name_input, double z, double dist, double m, double omega):celestial_object(std::move(name_input), z, dist, m, omega)
             {
                 object_type = celestial_types::Comet;
             }
 
-            virtual void get_additional_properties() override
-            {
-                std::cout << "No additional properties. " << std::endl;
-            }
+            virtual void write_additional_properties(export_buffer& report_data) override;
     };
 
     class asteroid : public celestial_object
@@ -676,15 +773,12 @@ namespace celestial_objects
             asteroid(const asteroid& aster):celestial_object(aster){object_type = celestial_types::Asteroid;}
             asteroid(asteroid&& aster):celestial_object(aster){object_type = celestial_types::Asteroid;}
 
-            asteroid(std::string name_input, double z, double dist, double m, double omega):celestial_object(name_input, z, dist, m, omega)
+            asteroid(std::string name_input, double z, double dist, double m, double omega):celestial_object(std::move(name_input), z, dist, m, omega)
             {
                 object_type = celestial_types::Asteroid;
             }
 
-            virtual void get_additional_properties() override
-            {
-                std::cout << "No additional properties. " << std::endl;
-            }
+            virtual void write_additional_properties(export_buffer& report_data) override;
     };
 
     class satellite
@@ -704,6 +798,7 @@ namespace celestial_objects
             friend class celestial_object;
             friend class galaxy;
             friend class star;
+            friend class catalogue;
 
             satellite() = default;
 
@@ -763,15 +858,13 @@ namespace celestial_objects
             }
 
             //friend void catalogue::export_to_file();
-            friend void celestial_object::export_to_file(std::fstream& object_dat, std::fstream& relation_dat);
-            friend void galaxy::export_to_file(std::fstream& object_dat, std::fstream& relation_dat);
-            friend void star::export_to_file(std::fstream& object_dat, std::fstream& relation_dat);
+            friend void celestial_object::export_relationship(export_buffer& relation_data, int index);
 
             satellite(const satellite& sat)
             {
                 this->orbit_distance = sat.orbit_distance;
                 this->orbit_tilt = sat.orbit_tilt;
-                this->orbit_eccentricity = sat.orbit_tilt;
+                this->orbit_eccentricity = sat.orbit_eccentricity;
                 this->satellite_object = sat.satellite_object;
             }
 
@@ -782,7 +875,7 @@ namespace celestial_objects
                 } else{
                     this->orbit_distance = sat.orbit_distance;
                     this->orbit_tilt = sat.orbit_tilt;
-                    this->orbit_eccentricity = sat.orbit_tilt;
+                    this->orbit_eccentricity = sat.orbit_eccentricity;
                     this->satellite_object = sat.satellite_object;
                     return *this;
                 }
@@ -826,7 +919,7 @@ namespace celestial_objects
             stellar_remnant(stellar_remnant&& strem):star(strem){object_type = celestial_types::StellarRemnant;}
 
             stellar_remnant(std::string name_input, double z, double dist, double m, double omega, stellar_types s_type,
-            int s_digit, luminosity_class lum_no, double abs_mag, double app_mag):star(name_input, z, dist, m, omega,
+            int s_digit, luminosity_class lum_no, double abs_mag, double app_mag):star(std::move(name_input), z, dist, m, omega,
             s_type, s_digit, lum_no, abs_mag, app_mag)
             {
                 object_type = celestial_types::StellarRemnant;
@@ -847,7 +940,7 @@ namespace celestial_objects
             supernova(supernova&& nova):stellar_remnant(nova){object_type = celestial_types::Supernova;}
 
             supernova(std::string name_input, double z, double dist, double m, double omega, stellar_types s_type,
-            int s_digit, luminosity_class lum_no, double abs_mag, double app_mag):stellar_remnant(name_input, z, dist, m, omega,
+            int s_digit, luminosity_class lum_no, double abs_mag, double app_mag):stellar_remnant(std::move(name_input), z, dist, m, omega,
             s_type, s_digit, lum_no, abs_mag, app_mag)
             {
                 object_type = celestial_types::Supernova;
@@ -868,7 +961,7 @@ namespace celestial_objects
             neutron_star(neutron_star&& nstar):stellar_remnant(nstar){object_type = celestial_types::NeutronStar;}
 
             neutron_star(std::string name_input, double z, double dist, double m, double omega, stellar_types s_type,
-            int s_digit, luminosity_class lum_no, double abs_mag, double app_mag):stellar_remnant(name_input, z, dist, m, omega,
+            int s_digit, luminosity_class lum_no, double abs_mag, double app_mag):stellar_remnant(std::move(name_input), z, dist, m, omega,
             s_type, s_digit, lum_no, abs_mag, app_mag)
             {
                 object_type = celestial_types::NeutronStar;
@@ -889,8 +982,8 @@ namespace celestial_objects
             pulsar(const pulsar& puls):neutron_star(puls){object_type = celestial_types::Pulsar;}
             pulsar(pulsar&& puls):neutron_star(puls){object_type = celestial_types::Pulsar;}
 
-            pulsar(std::string& name_input, double& z, double& dist, double& m, double omega, stellar_types s_type,
-            int s_digit, luminosity_class lum_no, double abs_mag, double app_mag):neutron_star(name_input, z, dist, m, omega,
+            pulsar(std::string name_input, double z, double dist, double m, double omega, stellar_types s_type,
+            int s_digit, luminosity_class lum_no, double abs_mag, double app_mag):neutron_star(std::move(name_input), z, dist, m, omega,
             s_type, s_digit, lum_no, abs_mag, app_mag)
             {
                 object_type = celestial_types::Pulsar;
@@ -912,30 +1005,584 @@ namespace celestial_objects
             black_hole(const black_hole& bh):celestial_object(bh){object_type = celestial_types::BlackHole;}
             black_hole(black_hole&& bh):celestial_object(bh){object_type = celestial_types::BlackHole;}
 
-            black_hole(std::string name_input, double z, double dist, double m, double omega):celestial_object(name_input, z, dist, m, omega)
+            black_hole(std::string name_input, double z, double dist, double m, double omega):celestial_object(std::move(name_input), z, dist, m, omega)
             {
                 object_type = celestial_types::BlackHole;
             }
 
-            virtual void get_additional_properties() override
-            {
-                std::cout << "No additional properties. " << std::endl;
-            }
+            virtual void write_additional_properties(export_buffer& report_data) override;
     }; 
 
+    //Upper bound on the number of ':' delimited fields in a single line of a catalogue file
+    constexpr std::size_t max_line_fields{16};
+    //Upper bound on the number of threads used by any parallel catalogue operation
+    constexpr int max_worker_threads{16};
+    //Size of each block of memory requested by an object_arena
+    constexpr std::size_t arena_slab_size{64 * 1024};
+    //Amount of formatted text an export_buffer collects before writing it out in one block
+    constexpr std::size_t export_block_size{4 * 1024 * 1024};
+    //Number of objects each export worker formats per round, which bounds the memory held by the workers' buffers
+    constexpr std::size_t export_objects_per_worker{16384};
+    //Number of objects each report worker renders per round, and the number of objects shown on each page of a paged report
+    constexpr std::size_t report_objects_per_worker{4096};
+    constexpr std::size_t report_page_size{10};
+    //Finest level of the sky pixel index, which divides the sky into 2 * 4^level pixels of equal area
+    constexpr int sky_index_level{13};
+    constexpr double degrees_to_radians{3.14159265358979323846 / 180};
+    //Largest number of points a k-d tree leaves unsplit, as scanning a few points is quicker than descending further
+    constexpr int kd_tree_leaf_size{8};
+    //Largest number of ids held in one chunk of a chunked_index, which bounds how many ids an insertion or removal moves
+    constexpr std::size_t index_chunk_size{512};
+
+    class object_arena
+    {
+        /* Monotonic memory arena from which catalogue objects are allocated. Memory is taken from large slabs in order, so objects
+        built one after another sit next to each other in memory and an import costs one allocation per slab rather than one per object.
+        Individual deallocations do nothing; the slabs are all released together when the arena is destroyed, which happens once every
+        object allocated from it has been destroyed. An arena must only be allocated from by one thread at a time. */
+        private:
+            std::vector<std::unique_ptr<char[]>> slabs{};
+            char* slab_position{nullptr};
+            std::size_t slab_remaining{0};
+
+        public:
+            object_arena() = default;
+            object_arena(const object_arena&) = delete;
+            object_arena& operator=(const object_arena&) = delete;
+
+            void* allocate(std::size_t size, std::size_t alignment);
+            std::size_t get_slab_number()const{return slabs.size();}
+    };
+
+    template<typename T>
+    class arena_allocator
+    {
+        /* Standard allocator handing out memory from an object_arena. Each copy shares ownership of the arena, so an object built
+        with std::allocate_shared keeps its arena alive through its control block for as long as the object exists. */
+        public:
+            using value_type = T;
+            std::shared_ptr<object_arena> arena;
+
+            explicit arena_allocator(std::shared_ptr<object_arena> arena_ptr):arena(std::move(arena_ptr)){}
+            template<typename U>
+            arena_allocator(const arena_allocator<U>& allocator):arena(allocator.arena){}
+
+            T* allocate(std::size_t n){return static_cast<T*>(arena->allocate(n * sizeof(T), alignof(T)));}
+            void deallocate(T*, std::size_t){}
+
+            template<typename U>
+            bool operator==(const arena_allocator<U>& allocator)const{return arena == allocator.arena;}
+            template<typename U>
+            bool operator!=(const arena_allocator<U>& allocator)const{return arena != allocator.arena;}
+    };
+
+    template<typename T, typename... Args>
+    std::shared_ptr<T> make_arena_object(const std::shared_ptr<object_arena>& arena, Args&&... args)
+    {
+        //Constructs an object in place within the arena, with its shared_ptr control block alongside it
+        return std::allocate_shared<T>(arena_allocator<T>(arena), std::forward<Args>(args)...);
+    }
+
+    class mapped_file
+    {
+        /* Read-only view over the whole contents of a file, used by the catalogue import so that lines and fields can be
+        parsed in place as std::string_views. On POSIX systems the file is memory mapped, otherwise it is read into a single buffer. 
+        Copying is disabled as the mapping is released when the object is destroyed. */
+        private:
+            const char* file_data{nullptr};
+            std::size_t file_size{0};
+            std::string file_buffer{};
+            bool mapped{false};
+            bool opened{false};
+
+        public:
+            mapped_file() = default;
+            mapped_file(const mapped_file&) = delete;
+            mapped_file& operator=(const mapped_file&) = delete;
+            ~mapped_file(){close();}
+
+            bool open(const std::string& path);
+            void close();
+            bool is_open()const{return opened;}
+            std::string_view contents()const{return std::string_view(file_data, file_size);}
+    };
+
+    class export_buffer
+    {
+        /* Collects formatted text for a catalogue file in one large reusable block, which is written to its stream whenever it
+        grows past export_block_size. Numbers are formatted with std::to_chars, using the same precision as a default std::ostream,
+        so the text is identical to streaming the same values but is produced without any locale lookups or stream overhead.
+        A buffer made without a stream only collects text in memory. */
+        private:
+            std::ostream* destination{nullptr};
+            std::string buffer{};
+
+            export_buffer& check_size(){if(destination != nullptr && buffer.size() >= export_block_size){flush();} return *this;}
+
+        public:
+            export_buffer() = default;
+            explicit export_buffer(std::ostream& output):destination(&output){buffer.reserve(export_block_size + 64);}
+            export_buffer(const export_buffer&) = delete;
+            export_buffer& operator=(const export_buffer&) = delete;
+            ~export_buffer(){flush();}
+
+            export_buffer& operator<<(std::string_view text){buffer.append(text); return check_size();}
+            export_buffer& operator<<(char character){buffer.push_back(character); return check_size();}
+            export_buffer& operator<<(double value);
+            export_buffer& operator<<(int value);
+            void flush();
+            void write_to(std::ostream& output){output.write(buffer.data(), std::streamsize(buffer.size())); buffer.clear();}
+            const std::string& contents()const{return buffer;}
+    };
+
+    class operation_log
+    {
+        /* Append-only log of the changes made to a catalogue since it was last saved, so that they can be recovered after a crash.
+        Appending a record copies it into a pending buffer and waits for it to be committed, while a writer thread moves everything
+        pending to the file and syncs it to disk in one go. Each record is numbered as it is appended, and the writer advances the
+        committed number past the whole batch once its sync has finished, so a record is on disk when its append returns. Records
+        appended during a sync are committed together by the next one, so a single sync is shared by every record it carries.
+        On POSIX systems the file is exclusively locked while it is open, so that two catalogues can never log to the same file.
+        Copying is disabled as the writer thread uses the log's own address. */
+        private:
+            std::string log_path{""};
+            std::FILE* log_file{nullptr};
+            std::string pending{};
+            std::uint64_t appended_sequence{0};
+            std::uint64_t committed_sequence{0};
+            bool stopping{false};
+            bool failed{false};
+            bool in_use{false};
+            std::mutex log_mutex;
+            std::condition_variable log_condition;
+            std::condition_variable commit_condition;
+            std::thread writer;
+
+            void write_pending();
+
+        public:
+            operation_log() = default;
+            operation_log(const operation_log&) = delete;
+            operation_log& operator=(const operation_log&) = delete;
+            ~operation_log(){close();}
+
+            bool open(const std::string& path);
+            void close();
+            bool append(std::string_view record);
+            bool truncate(std::size_t size);
+            bool is_open()const{return log_file != nullptr;}
+            //True if the last open failed because another log already holds the file
+            bool is_in_use()const{return in_use;}
+            const std::string& get_path()const{return log_path;}
+    };
+
+    struct object_parameters
+    {
+        /* Every value needed to construct any type of celestial object. Filled in by the text and binary import paths
+        and passed to the catalogue to build the object itself. Values which do not apply to a type are ignored. */
+        celestial_types object_type{celestial_types::Unassigned};
+        std::string name{""};
+        double redshift{0};
+        double distance{0};
+        double mass{0};
+        double rotational_velocity{0};
+        double stellar_mass_fraction{0};
+        hubble_types hubble_type{hubble_types::Unassigned};
+        stellar_types star_type{stellar_types::Unassigned};
+        int stellar_digit{0};
+        luminosity_class luminosity_id{luminosity_class::Unassigned};
+        double abs_magnitude{0};
+        double app_magnitude{0};
+        double right_ascension{0};
+        double declination{0};
+    };
+
+    struct object_relationship
+    {
+        //A parent/child relationship to be made by catalogue::link_all(), with both objects given by their catalogue positions
+        int parent_position{0};
+        int child_position{0};
+        double orbit_distance{0};
+        double orbit_tilt{0};
+        double orbit_eccentricity{0};
+    };
+
+    //Reasons for which catalogue::link_all() may refuse a relationship
+    enum class link_errors{OutOfRange, AlreadyParented, SelfParent, ClosedLoop};
+    const std::vector<std::string> link_errors_output{"OutOfRange", "AlreadyParented", "SelfParent", "ClosedLoop"};
+    constexpr int link_error_number{4};
+
+    struct link_error
+    {
+        //A relationship refused by catalogue::link_all(), given by its index in the list that was passed in
+        std::size_t relationship_index{0};
+        link_errors error{link_errors::OutOfRange};
+    };
+
+    //Identifies a binary catalogue (.ccat) file and the version of its layout
+    constexpr char binary_catalogue_magic[4]{'C', 'C', 'A', 'T'};
+    constexpr std::uint32_t binary_catalogue_version{2};
+    constexpr std::uint32_t binary_byte_order_mark{0x01020304};
+
+    struct binary_catalogue_header
+    {
+        /* Fixed size header at the start of a binary catalogue. It is followed by a series of columns, each padded to a multiple
+        of 8 bytes: object types (uint8), redshift, distance, mass and rotational velocity (double), the galaxy columns for stellar
+        mass fraction (double) and Hubble type (uint8), the star columns for stellar type (uint8), stellar digit (int32), luminosity
+        class (uint8), absolute and apparent magnitude (double), right ascension and declination (double, from version 2), then n + 1 name offsets (uint64) into the name heap, the name heap
+        itself and finally the edge table of parent and child row numbers (int32) with the orbital distance, tilt and eccentricity
+        (double) of each edge. Type-specific columns hold zeroes for objects they do not apply to. Values are written in the byte order
+        of the exporting machine, which is recorded so that a mismatched file is rejected rather than misread. save_sequence is the
+        number of the save that wrote the file, as described for catalogue::save_sequence, and is zero in files written before saves
+        were numbered. */
+        char magic[4];
+        std::uint32_t version;
+        std::uint32_t byte_order;
+        std::uint32_t save_sequence;
+        std::uint64_t object_count;
+        std::uint64_t name_heap_size;
+        std::uint64_t edge_count;
+    };
+
+    class name_table
+    {
+        /* Interns the object names of a catalogue, storing each name once alongside a case-folded copy used as its sort key
+        and a precomputed hash. Names are given compact ids in the order they are added, and the table is searched by open
+        addressing over those ids, so lookups can be made directly from a std::string_view without building a std::string. */
+        private:
+            std::vector<std::string> names{};
+            std::vector<std::string> sort_keys{};
+            std::vector<std::uint64_t> hashes{};
+            //Each slot holds the id of a name or -1 when empty, and the table is kept at most half full
+            std::vector<int> slots{};
+
+            void rehash(std::size_t slot_number);
+
+        public:
+            int intern(std::string_view name);
+            int find(std::string_view name)const;
+            void reserve(std::size_t name_number);
+            const std::string& get_name(int id)const{return names[id];}
+            const std::string& get_sort_key(int id)const{return sort_keys[id];}
+            std::uint64_t get_hash(int id)const{return hashes[id];}
+            int size()const{return int(names.size());}
+    };
+
+    class chunked_index
+    {
+        /* Ordered list of object ids, split into chunks of at most index_chunk_size ids, used for the catalogue's secondary and sky indexes.
+        The ids carry no keys of their own, so searches take a predicate telling whether an id belongs before the place sought, which
+        must be true for some leading run of the ids and false for the rest. Inserting or removing an id binary searches for its chunk
+        and then moves only the ids after it within that chunk, so keeping an index up to date takes O(log n + index_chunk_size) time
+        rather than moving every later id in one long array. A chunk that grows past the limit is split in two and an empty one is dropped. */
+        private:
+            std::vector<std::vector<int>> chunks{};
+            int id_number{0};
+
+        public:
+            class iterator
+            {
+                /* Iterates over the ids of an index in order. Any insertion or removal invalidates every iterator. */
+                friend class chunked_index;
+                private:
+                    const std::vector<std::vector<int>>* chunks{nullptr};
+                    std::size_t chunk{0};
+                    std::size_t offset{0};
+
+                public:
+                    using iterator_category = std::forward_iterator_tag;
+                    using value_type = int;
+                    using difference_type = std::ptrdiff_t;
+                    using pointer = const int*;
+                    using reference = const int&;
+
+                    iterator() = default;
+                    iterator(const std::vector<std::vector<int>>* index_chunks, std::size_t chunk_number, std::size_t chunk_offset):
+                    chunks(index_chunks), chunk(chunk_number), offset(chunk_offset){}
+
+                    const int& operator*()const{return (*chunks)[chunk][offset];}
+                    iterator& operator++()
+                    {
+                        if(++offset == (*chunks)[chunk].size()){
+                            chunk++;
+                            offset = 0;
+                        }
+                        return *this;
+                    }
+                    iterator operator++(int){iterator previous{*this}; ++*this; return previous;}
+                    bool operator==(const iterator& other)const{return chunk == other.chunk && offset == other.offset;}
+                    bool operator!=(const iterator& other)const{return !(*this == other);}
+            };
+
+            void assign(const std::vector<int>& ids);
+            void clear(){std::vector<std::vector<int>>().swap(chunks); id_number = 0;}
+            template<typename P>
+            iterator partition_point(P&& is_before)const;
+            template<typename P>
+            void insert(int id, P&& is_before);
+            template<typename P>
+            bool erase(int id, P&& is_before);
+            std::vector<int> ids(iterator first, iterator last)const;
+
+            iterator begin()const{return iterator(&chunks, 0, 0);}
+            iterator end()const{return iterator(&chunks, chunks.size(), 0);}
+            int size()const{return id_number;}
+            bool empty()const{return id_number == 0;}
+    };
+
+    template<typename P>
+    chunked_index::iterator chunked_index::partition_point(P&& is_before)const
+    {
+        //Finds the first chunk whose last id does not belong before the place sought, then the place within that chunk
+        std::vector<std::vector<int>>::const_iterator chunk{std::partition_point(chunks.begin(), chunks.end(),
+        [&](const std::vector<int>& ids){return is_before(ids.back());})};
+        if(chunk == chunks.end()){
+            return end();
+        }
+        return iterator(&chunks, std::size_t(chunk - chunks.begin()), std::size_t(std::partition_point(chunk->begin(), chunk->end(), is_before) - chunk->begin()));
+    }
+
+    template<typename P>
+    void chunked_index::insert(int id, P&& is_before)
+    {
+        //An id belonging after every other goes at the end of the last chunk
+        if(chunks.empty()){
+            chunks.emplace_back(1, id);
+            id_number++;
+            return;
+        }
+        iterator place{partition_point(is_before)};
+        std::size_t chunk{place.chunk};
+        std::size_t offset{place.offset};
+        if(chunk == chunks.size()){
+            chunk--;
+            offset = chunks[chunk].size();
+        }
+        std::vector<int>& ids{chunks[chunk]};
+        ids.insert(ids.begin() + std::ptrdiff_t(offset), id);
+        if(ids.size() > index_chunk_size){
+            std::vector<int> upper_half(ids.begin() + std::ptrdiff_t(ids.size() / 2), ids.end());
+            ids.resize(ids.size() / 2);
+            chunks.insert(chunks.begin() + std::ptrdiff_t(chunk + 1), std::move(upper_half));
+        }
+        id_number++;
+    }
+
+    template<typename P>
+    bool chunked_index::erase(int id, P&& is_before)
+    {
+        //The predicate must place the id itself first among any equal ids, so that the id sits at the place found
+        iterator place{partition_point(is_before)};
+        if(place == end() || *place != id){
+            return false;
+        }
+        std::vector<int>& ids{chunks[place.chunk]};
+        ids.erase(ids.begin() + std::ptrdiff_t(place.offset));
+        if(ids.empty()){
+            chunks.erase(chunks.begin() + std::ptrdiff_t(place.chunk));
+        }
+        id_number--;
+        return true;
+    }
+
+    //A position in space, in parsecs, with the x axis towards right ascension 0 and the z axis towards the north celestial pole
+    using cartesian_position = std::array<double, 3>;
+
+    class kd_tree
+    {
+        /* Three dimensional k-d tree over a fixed set of points, each labelled with an id. The tree is stored implicitly: points are
+        reordered so that the median of every range is its splitting node, with the points before and after it forming its two subtrees,
+        so no child pointers are needed. Each range is split along whichever axis its points are most spread out in.
+        Queries do not modify the tree, so any number of them may run at once on separate threads. */
+        private:
+            std::vector<cartesian_position> points{};
+            std::vector<int> ids{};
+            //The axis each node splits its range along, held at the node's own index
+            std::vector<std::uint8_t> split_axes{};
+
+            void build_range(std::vector<int>& order, std::size_t begin, std::size_t end, int spare_threads);
+            void search_nearest(const cartesian_position& point, std::size_t begin, std::size_t end, std::size_t k, int excluded_id,
+            std::vector<std::pair<double, int>>& nearest)const;
+            void search_within(const cartesian_position& point, std::size_t begin, std::size_t end, double radius_squared, int excluded_id,
+            std::vector<std::pair<double, int>>& found)const;
+
+        public:
+            void build(const std::vector<cartesian_position>& new_points, const std::vector<int>& new_ids);
+            std::vector<std::pair<double, int>> nearest(const cartesian_position& point, int k, int excluded_id)const;
+            std::vector<std::pair<double, int>> within(const cartesian_position& point, double radius, int excluded_id)const;
+            int size()const{return int(ids.size());}
+    };
+
+    struct parameter_statistics
+    {
+        /* Summary of a numeric parameter across a whole catalogue, calculated from the catalogue's column store. */
+        int count{0};
+        double sum{0};
+        double mean{0};
+        double minimum{0};
+        double maximum{0};
+    };
+
+    struct import_chunk
+    {
+        /* One section of an object file, split at a line boundary, along with the objects parsed from it by an import worker
+        and any error messages produced. Results are held per chunk so that they can be merged back in file order. */
+        std::string_view text;
+        std::vector<std::shared_ptr<celestial_object>> objects;
+        std::string messages;
+        //Each worker allocates from its own arena, as arenas cannot be shared between threads
+        std::shared_ptr<object_arena> arena{std::make_shared<object_arena>()};
+    };
+
+    class catalogue_selection;
+
     class catalogue
     {
         /* Acts as a container for all celestial objects in a given collection. */
         private:
             std::string catalogue_name{""};
             std::vector<std::shared_ptr<celestial_object>> catalogue_objects{};
-            std::vector<std::string> local_object_names{};
+            //Every object name is interned once here, and the catalogue refers to names by their id from then on
+            name_table object_names{};
+            //The name id of the object at each position, and the position of the object with each name id
+            //Both must be kept in step with catalogue_objects whenever objects are added or the catalogue is reordered
+            std::vector<int> name_id_column{};
+            std::vector<int> name_positions{};
+            //Every object is given a permanent id in the order it is added, which stays the same when the catalogue is reordered
+            //The object id at each position, and the position of each object id
+            std::vector<int> object_id_column{};
+            std::vector<int> object_positions{};
             int object_amount{0};
+            //Column store holding a dense copy of each object's numeric data, in the same order as catalogue_objects
+            //Scans, filters and sorts read these arrays rather than dereferencing every object
+            std::vector<double> redshift_column{};
+            std::vector<double> distance_column{};
+            std::vector<double> mass_column{};
+            std::vector<double> rotational_velocity_column{};
+            std::vector<double> right_ascension_column{};
+            std::vector<double> declination_column{};
+            std::vector<celestial_types> type_column{};
+            std::vector<hubble_types> hubble_type_column{};
+            std::vector<stellar_types> stellar_type_column{};
+            std::vector<int> member_number_column{};
+            //Flat store of the parent/child hierarchy. The per-object arrays are indexed by object id rather than position, so that
+            //they are unaffected by sorting. Every relationship is an edge, whose child, next edge and orbital parameters are held in
+            //separate arrays, and each object's edges form a list through next_edges from its first to its last, in the order they
+            //were made. As an object has at most one parent, parent_edges gives the edge joining each object to its parent
+            //-1 marks no parent, no edges or the end of a list
+            std::vector<int> parent_ids{};
+            std::vector<int> parent_edges{};
+            std::vector<int> first_edges{};
+            std::vector<int> last_edges{};
+            std::vector<int> edge_child_ids{};
+            std::vector<int> next_edges{};
+            std::vector<double> edge_orbit_distances{};
+            std::vector<double> edge_orbit_tilts{};
+            std::vector<double> edge_orbit_eccentricities{};
+            //Union-find over the trees of the hierarchy, so that the root and depth of any object are found in near constant time
+            //Each set is one tree, whose representative holds the set's size and the id of the tree's actual root. Depths are held as
+            //offsets from each object to the next along its path to the representative, and an object's depth is the sum of the offsets
+            //along its path less that of its root's. As relationships are never removed, sets only ever need to be merged
+            std::vector<int> hierarchy_links{};
+            std::vector<int> hierarchy_sizes{};
+            std::vector<int> hierarchy_roots{};
+            std::vector<int> depth_offsets{};
+            //Totals over each object's system, being the object and everything below it, kept up to date as relationships are added
+            //Mass includes the object itself, whereas the member and type counts and the largest orbital distance cover only its descendants
+            //Type counts are held in one array, with celestial_type_number entries per object id
+            std::vector<double> system_masses{};
+            std::vector<int> system_sizes{};
+            std::vector<int> system_type_counts{};
+            std::vector<double> system_orbit_distances{};
+            //Optional secondary indexes, each holding every object id in order of one parameter, with ties in the order objects were added
+            //Only the parameters marked in indexed_parameters are maintained, and they are kept up to date as objects are added
+            std::array<chunked_index, parameter_number> sorted_indexes{};
+            std::array<bool, parameter_number> indexed_parameters{};
+            //Sky pixel index, giving the finest level pixel of the object at each position, and every object id in order of pixel
+            //with ties in the order objects were added. Indexed ids are searched by looking their pixels up in the column
+            std::vector<std::uint32_t> sky_pixel_column{};
+            chunked_index sky_index{};
+            //Set during bulk imports, which rebuild the indexes once at the end rather than updating them for every object
+            bool indexes_deferred{false};
+            //Tree over the positions of every object in space, which is only rebuilt when a neighbour query is made after objects are
+            //added or moved, so a series of additions costs a single rebuild
+            kd_tree neighbour_tree{};
+            bool neighbour_tree_stale{true};
+            //Changes made since the catalogue was last loaded from or written to its .dat files, which save_changes() appends to them
+            //Objects which are new or have changed are held by id, and new relationships by edge
+            std::string save_path{""};
+            std::vector<int> changed_objects{};
+            std::vector<bool> object_changed{};
+            std::vector<int> new_relationships{};
+            //Log of every change since the last save, kept beside the .dat or .ccat file the catalogue was loaded from so that a crash
+            //loses no work. log_started is set once a log has been tried, so a catalogue made from scratch opens its log on its first
+            //change. A copy of a catalogue neither shares its log nor starts one, so only the original's changes are recovered
+            std::unique_ptr<operation_log> change_log{};
+            bool log_started{false};
+            //Number of the last save written to the catalogue's files. Each save marks what it writes with the next number, and a log
+            //starts with the number of the save it follows, so a log left behind by a crash just after a save is not replayed over it
+            int save_sequence{0};
+            //Arena used for objects created outside of a text import
+            std::shared_ptr<object_arena> object_storage{std::make_shared<object_arena>()};
             std::vector<std::shared_ptr<celestial_object>>::iterator catalogue_begin{catalogue_objects.begin()};
             std::vector<std::shared_ptr<celestial_object>>::iterator catalogue_end{catalogue_objects.end()};
             std::vector<std::shared_ptr<celestial_object>>::iterator catalogue_position{catalogue_objects.begin()};
+
+            std::shared_ptr<celestial_object> parse_object_line(std::string_view line, const std::shared_ptr<object_arena>& arena);
+            void parse_object_fields(std::string_view line, object_parameters& parameters);
+            void replay_object_deltas(std::string_view delta_text);
+            void apply_object_line(std::string_view line);
+            void recover_operation_log(const std::string& log_path);
+            void restart_operation_log();
+            bool open_operation_log(const std::string& log_path);
+            bool clear_operation_log();
+            int replay_operation_log(std::string_view log_text);
+            void log_object(int position);
+            void log_relationship(int edge);
+            bool logging_changes();
+            void write_log_record(const std::string& record);
+            bool can_link(int parent_position, int child_position);
+            void link_objects(int parent_position, int child_position, double orb_distance, double orb_tilt, double orb_eccentricity);
+            void join_hierarchy_sets(int parent_id, int child_id);
+            void report_link_errors(const std::vector<link_error>& errors);
+            void export_relationship(export_buffer& relation_data, int edge);
+            void export_relationships(export_buffer& relation_data, int position);
+            void write_properties(export_buffer& report_data, int position);
+            void write_report_summary(export_buffer& report_data);
+            object_parameters get_parameters(int position);
+            void update_object(int position, const object_parameters& new_parameters);
+            void mark_changed(int object_id);
+            void clear_changes();
+            std::shared_ptr<celestial_object> construct_object(object_parameters& parameters, const std::shared_ptr<object_arena>& arena);
+            void parse_object_chunk(import_chunk& chunk);
+            void register_object(std::shared_ptr<celestial_object> object_ptr);
+            void reserve_objects(std::size_t added_number);
+            void compact_edges();
+            int find_hierarchy_set(int object_id, int& offset_sum);
+            int hierarchy_root(int object_id);
+            void apply_permutation(const std::vector<int>& order);
+            const std::vector<double>& numeric_column(parameters parameter);
+            template<typename F>
+            void visit_sort_key(parameters parameter, F&& visitor);
+            std::vector<int> sorted_order(parameters parameter, bool order_ids);
+            void build_index(parameters parameter);
+            void rebuild_indexes();
+            void rebuild_system_totals();
+            void add_to_system_totals(int parent_id, int child_id, int edge);
+            void insert_into_index(parameters parameter, int object_id);
+            void remove_from_index(parameters parameter, int object_id);
+            void update_member_number(int position, int member_number);
+            void build_sky_index();
+            void insert_into_sky_index(int object_id);
+            void remove_from_sky_index(int object_id);
+            const kd_tree& neighbour_index();
+            cartesian_position object_cartesian_position(int position)const;
+            template<typename F>
+            std::vector<catalogue_selection> run_neighbour_queries(const std::vector<int>& positions, F&& query);
             
         public:
+            friend class catalogue_selection;
+
             catalogue()
             {
                 import_from_file();
@@ -950,8 +1597,52 @@ namespace celestial_objects
             {
                 this->catalogue_name = cat.catalogue_name;
                 this->catalogue_objects = cat.catalogue_objects;
-                this->local_object_names = cat.local_object_names;
                 this->object_amount = cat.object_amount;
+                this->redshift_column = cat.redshift_column;
+                this->distance_column = cat.distance_column;
+                this->mass_column = cat.mass_column;
+                this->rotational_velocity_column = cat.rotational_velocity_column;
+                this->type_column = cat.type_column;
+                this->member_number_column = cat.member_number_column;
+                this->object_names = cat.object_names;
+                this->name_id_column = cat.name_id_column;
+                this->name_positions = cat.name_positions;
+                this->object_id_column = cat.object_id_column;
+                this->object_positions = cat.object_positions;
+                this->hubble_type_column = cat.hubble_type_column;
+                this->stellar_type_column = cat.stellar_type_column;
+                this->sorted_indexes = cat.sorted_indexes;
+                this->indexed_parameters = cat.indexed_parameters;
+                this->right_ascension_column = cat.right_ascension_column;
+                this->declination_column = cat.declination_column;
+                this->sky_pixel_column = cat.sky_pixel_column;
+                this->sky_index = cat.sky_index;
+                this->neighbour_tree = cat.neighbour_tree;
+                this->neighbour_tree_stale = cat.neighbour_tree_stale;
+                //A copy has no files of its own to append changes to, so saving it exports it in full
+                this->save_path = "";
+                this->log_started = true;
+                this->save_sequence = 0;
+                this->changed_objects = cat.changed_objects;
+                this->object_changed = cat.object_changed;
+                this->new_relationships = cat.new_relationships;
+                this->parent_ids = cat.parent_ids;
+                this->first_edges = cat.first_edges;
+                this->last_edges = cat.last_edges;
+                this->next_edges = cat.next_edges;
+                this->parent_edges = cat.parent_edges;
+                this->edge_child_ids = cat.edge_child_ids;
+                this->edge_orbit_distances = cat.edge_orbit_distances;
+                this->edge_orbit_tilts = cat.edge_orbit_tilts;
+                this->edge_orbit_eccentricities = cat.edge_orbit_eccentricities;
+                this->hierarchy_links = cat.hierarchy_links;
+                this->hierarchy_sizes = cat.hierarchy_sizes;
+                this->hierarchy_roots = cat.hierarchy_roots;
+                this->depth_offsets = cat.depth_offsets;
+                this->system_masses = cat.system_masses;
+                this->system_sizes = cat.system_sizes;
+                this->system_type_counts = cat.system_type_counts;
+                this->system_orbit_distances = cat.system_orbit_distances;
                 this->catalogue_begin = this->catalogue_objects.begin();
                 this->catalogue_end = this->catalogue_objects.end();
                 this->catalogue_position = this->catalogue_objects.begin();
@@ -964,8 +1655,52 @@ namespace celestial_objects
                 } else{
                     this->catalogue_name = cat.catalogue_name;
                     this->catalogue_objects = cat.catalogue_objects;
-                    this->local_object_names = cat.local_object_names;
                     this->object_amount = cat.object_amount;
+                    this->redshift_column = cat.redshift_column;
+                    this->distance_column = cat.distance_column;
+                    this->mass_column = cat.mass_column;
+                    this->rotational_velocity_column = cat.rotational_velocity_column;
+                    this->type_column = cat.type_column;
+                    this->member_number_column = cat.member_number_column;
+                    this->object_names = cat.object_names;
+                    this->name_id_column = cat.name_id_column;
+                    this->name_positions = cat.name_positions;
+                    this->object_id_column = cat.object_id_column;
+                    this->object_positions = cat.object_positions;
+                    this->hubble_type_column = cat.hubble_type_column;
+                    this->stellar_type_column = cat.stellar_type_column;
+                    this->sorted_indexes = cat.sorted_indexes;
+                    this->indexed_parameters = cat.indexed_parameters;
+                    this->right_ascension_column = cat.right_ascension_column;
+                    this->declination_column = cat.declination_column;
+                    this->sky_pixel_column = cat.sky_pixel_column;
+                    this->sky_index = cat.sky_index;
+                    this->neighbour_tree = cat.neighbour_tree;
+                    this->neighbour_tree_stale = cat.neighbour_tree_stale;
+                    //A copy has no files of its own to append changes to, so saving it exports it in full
+                    this->save_path = "";
+                    this->log_started = true;
+                    this->save_sequence = 0;
+                    this->changed_objects = cat.changed_objects;
+                    this->object_changed = cat.object_changed;
+                    this->new_relationships = cat.new_relationships;
+                    this->parent_ids = cat.parent_ids;
+                    this->first_edges = cat.first_edges;
+                    this->last_edges = cat.last_edges;
+                    this->next_edges = cat.next_edges;
+                    this->parent_edges = cat.parent_edges;
+                    this->edge_child_ids = cat.edge_child_ids;
+                    this->edge_orbit_distances = cat.edge_orbit_distances;
+                    this->edge_orbit_tilts = cat.edge_orbit_tilts;
+                    this->edge_orbit_eccentricities = cat.edge_orbit_eccentricities;
+                    this->hierarchy_links = cat.hierarchy_links;
+                    this->hierarchy_sizes = cat.hierarchy_sizes;
+                    this->hierarchy_roots = cat.hierarchy_roots;
+                    this->depth_offsets = cat.depth_offsets;
+                    this->system_masses = cat.system_masses;
+                    this->system_sizes = cat.system_sizes;
+                    this->system_type_counts = cat.system_type_counts;
+                    this->system_orbit_distances = cat.system_orbit_distances;
                     this->catalogue_begin = this->catalogue_objects.begin();
                     this->catalogue_end = this->catalogue_objects.end();
                     this->catalogue_position = this->catalogue_objects.begin();
@@ -977,8 +1712,52 @@ namespace celestial_objects
             {
                 std::swap(this->catalogue_name, cat.catalogue_name);
                 std::swap(this->catalogue_objects, cat.catalogue_objects);
-                std::swap(this->local_object_names, cat.local_object_names);
                 std::swap(this->object_amount, cat.object_amount);
+                std::swap(this->redshift_column, cat.redshift_column);
+                std::swap(this->distance_column, cat.distance_column);
+                std::swap(this->mass_column, cat.mass_column);
+                std::swap(this->rotational_velocity_column, cat.rotational_velocity_column);
+                std::swap(this->type_column, cat.type_column);
+                std::swap(this->member_number_column, cat.member_number_column);
+                std::swap(this->object_names, cat.object_names);
+                std::swap(this->name_id_column, cat.name_id_column);
+                std::swap(this->name_positions, cat.name_positions);
+                std::swap(this->object_id_column, cat.object_id_column);
+                std::swap(this->object_positions, cat.object_positions);
+                std::swap(this->hubble_type_column, cat.hubble_type_column);
+                std::swap(this->stellar_type_column, cat.stellar_type_column);
+                std::swap(this->sorted_indexes, cat.sorted_indexes);
+                std::swap(this->indexed_parameters, cat.indexed_parameters);
+                std::swap(this->right_ascension_column, cat.right_ascension_column);
+                std::swap(this->declination_column, cat.declination_column);
+                std::swap(this->sky_pixel_column, cat.sky_pixel_column);
+                std::swap(this->sky_index, cat.sky_index);
+                std::swap(this->neighbour_tree, cat.neighbour_tree);
+                std::swap(this->neighbour_tree_stale, cat.neighbour_tree_stale);
+                std::swap(this->save_path, cat.save_path);
+                std::swap(this->changed_objects, cat.changed_objects);
+                std::swap(this->object_changed, cat.object_changed);
+                std::swap(this->new_relationships, cat.new_relationships);
+                std::swap(this->change_log, cat.change_log);
+                std::swap(this->log_started, cat.log_started);
+                std::swap(this->save_sequence, cat.save_sequence);
+                std::swap(this->parent_ids, cat.parent_ids);
+                std::swap(this->first_edges, cat.first_edges);
+                std::swap(this->last_edges, cat.last_edges);
+                std::swap(this->next_edges, cat.next_edges);
+                std::swap(this->parent_edges, cat.parent_edges);
+                std::swap(this->edge_child_ids, cat.edge_child_ids);
+                std::swap(this->edge_orbit_distances, cat.edge_orbit_distances);
+                std::swap(this->edge_orbit_tilts, cat.edge_orbit_tilts);
+                std::swap(this->edge_orbit_eccentricities, cat.edge_orbit_eccentricities);
+                std::swap(this->hierarchy_links, cat.hierarchy_links);
+                std::swap(this->hierarchy_sizes, cat.hierarchy_sizes);
+                std::swap(this->hierarchy_roots, cat.hierarchy_roots);
+                std::swap(this->depth_offsets, cat.depth_offsets);
+                std::swap(this->system_masses, cat.system_masses);
+                std::swap(this->system_sizes, cat.system_sizes);
+                std::swap(this->system_type_counts, cat.system_type_counts);
+                std::swap(this->system_orbit_distances, cat.system_orbit_distances);
                 this->catalogue_begin = this->catalogue_objects.begin();
                 this->catalogue_end = this->catalogue_objects.end();
                 this->catalogue_position = this->catalogue_objects.begin();
@@ -988,8 +1767,52 @@ namespace celestial_objects
             {
                 std::swap(this->catalogue_name, cat.catalogue_name);
                 std::swap(this->catalogue_objects, cat.catalogue_objects);
-                std::swap(this->local_object_names, cat.local_object_names);
                 std::swap(this->object_amount, cat.object_amount);
+                std::swap(this->redshift_column, cat.redshift_column);
+                std::swap(this->distance_column, cat.distance_column);
+                std::swap(this->mass_column, cat.mass_column);
+                std::swap(this->rotational_velocity_column, cat.rotational_velocity_column);
+                std::swap(this->type_column, cat.type_column);
+                std::swap(this->member_number_column, cat.member_number_column);
+                std::swap(this->object_names, cat.object_names);
+                std::swap(this->name_id_column, cat.name_id_column);
+                std::swap(this->name_positions, cat.name_positions);
+                std::swap(this->object_id_column, cat.object_id_column);
+                std::swap(this->object_positions, cat.object_positions);
+                std::swap(this->hubble_type_column, cat.hubble_type_column);
+                std::swap(this->stellar_type_column, cat.stellar_type_column);
+                std::swap(this->sorted_indexes, cat.sorted_indexes);
+                std::swap(this->indexed_parameters, cat.indexed_parameters);
+                std::swap(this->right_ascension_column, cat.right_ascension_column);
+                std::swap(this->declination_column, cat.declination_column);
+                std::swap(this->sky_pixel_column, cat.sky_pixel_column);
+                std::swap(this->sky_index, cat.sky_index);
+                std::swap(this->neighbour_tree, cat.neighbour_tree);
+                std::swap(this->neighbour_tree_stale, cat.neighbour_tree_stale);
+                std::swap(this->save_path, cat.save_path);
+                std::swap(this->changed_objects, cat.changed_objects);
+                std::swap(this->object_changed, cat.object_changed);
+                std::swap(this->new_relationships, cat.new_relationships);
+                std::swap(this->change_log, cat.change_log);
+                std::swap(this->log_started, cat.log_started);
+                std::swap(this->save_sequence, cat.save_sequence);
+                std::swap(this->parent_ids, cat.parent_ids);
+                std::swap(this->first_edges, cat.first_edges);
+                std::swap(this->last_edges, cat.last_edges);
+                std::swap(this->next_edges, cat.next_edges);
+                std::swap(this->parent_edges, cat.parent_edges);
+                std::swap(this->edge_child_ids, cat.edge_child_ids);
+                std::swap(this->edge_orbit_distances, cat.edge_orbit_distances);
+                std::swap(this->edge_orbit_tilts, cat.edge_orbit_tilts);
+                std::swap(this->edge_orbit_eccentricities, cat.edge_orbit_eccentricities);
+                std::swap(this->hierarchy_links, cat.hierarchy_links);
+                std::swap(this->hierarchy_sizes, cat.hierarchy_sizes);
+                std::swap(this->hierarchy_roots, cat.hierarchy_roots);
+                std::swap(this->depth_offsets, cat.depth_offsets);
+                std::swap(this->system_masses, cat.system_masses);
+                std::swap(this->system_sizes, cat.system_sizes);
+                std::swap(this->system_type_counts, cat.system_type_counts);
+                std::swap(this->system_orbit_distances, cat.system_orbit_distances);
                 this->catalogue_begin = this->catalogue_objects.begin();
                 this->catalogue_end = this->catalogue_objects.end();
                 this->catalogue_position = this->catalogue_objects.begin();
@@ -997,27 +1820,223 @@ namespace celestial_objects
             }
 
             ~catalogue() = default;
-            std::string get_name();
-            std::vector<std::string> get_obj_names(){return local_object_names;}
+            const std::string& get_name()const;
+            std::vector<std::string_view> get_obj_names();
             std::shared_ptr<celestial_object> get_object(std::string name);
             std::shared_ptr<celestial_object> get_object(int index);
-            void push_obj_name(std::string name){local_object_names.push_back(name);}
+            bool contains_object(std::string_view name){return object_names.find(name) != -1;}
+            int find_position(std::string_view name)const;
             int get_number(){return object_amount;}
             void import_from_file();
+            bool import_from_binary(const std::string& file_name);
             void export_to_file();
+            void save_changes();
+            bool has_changes()const{return !changed_objects.empty() || !new_relationships.empty();}
+            void export_to_binary();
             void add_object(celestial_object* object);
+            template<typename T, typename... Args>
+            std::shared_ptr<T> create_object(Args&&... args)
+            {
+                /* Constructs an object of type T in the catalogue's arena from the given constructor arguments and adds it to the catalogue.
+                This should be preferred over add_object(), which takes ownership of an object that must already be on the heap. */
+                std::shared_ptr<T> object_ptr{make_arena_object<T>(object_storage, std::forward<Args>(args)...)};
+                register_object(object_ptr);
+                return object_ptr;
+            }
             //void remove_object();
+            void add_member(std::string parent_name, std::string child_name);
+            void add_member(int parent_position, int child_position, double orb_distance, double orb_tilt, double orb_eccentricity);
+            std::vector<link_error> link_all(const std::vector<object_relationship>& relationships);
+            int get_parent(int position);
+            int get_root(int position);
+            int get_depth(int position);
+            double get_system_mass(int position);
+            int get_system_size(int position);
+            int get_system_type_count(int position, celestial_types object_type);
+            double get_system_orbit_distance(int position);
+            void get_system_properties(int position);
+            catalogue_selection get_members(int position);
+            int get_member_number(int position);
+            void get_properties(int position);
             void sort_catalogue(parameters& parameter);
             std::vector<std::shared_ptr<celestial_object>> subselect_catalogue(celestial_types& type);
+            std::vector<int> select_types(type_mask requested_types);
+            catalogue_selection make_selection(const std::vector<int>& positions);
+            catalogue_selection select_all();
+            void enable_index(parameters parameter);
+            void disable_index(parameters parameter);
+            bool has_index(parameters parameter)const{return indexed_parameters[int(parameter)];}
+            catalogue_selection sorted_view(parameters parameter);
+            catalogue_selection range_query(parameters parameter, double minimum, double maximum);
+            void set_sky_position(int position, double right_ascension, double declination);
+            catalogue_selection cone_search(double right_ascension, double declination, double radius);
+            catalogue_selection nearest_neighbours(int position, int k);
+            std::vector<catalogue_selection> nearest_neighbours(const std::vector<int>& positions, int k);
+            catalogue_selection neighbours_within(int position, double radius);
+            std::vector<catalogue_selection> neighbours_within(const std::vector<int>& positions, double radius);
+            std::vector<int> filter_catalogue(parameters parameter, double minimum, double maximum);
+            parameter_statistics get_statistics(parameters parameter);
             void generate_report();
+            void generate_report(std::ostream& output, report_modes mode);
+            bool generate_report(const std::string& file_name, report_modes mode);
+
+    };
+
+    class catalogue_selection
+    {
+        /* Non-owning view over a set of objects within a catalogue, held as the objects' permanent ids so that it remains valid when
+        the catalogue is sorted or added to. Iterating over a selection gives references to the objects themselves, so no shared_ptr
+        is copied and no reference count is touched. The catalogue must outlive any selection made from it. A selection of the whole
+        catalogue holds no ids of its own and instead reads the catalogue's live id column, so it always follows the current order. */
+        private:
+            catalogue* source_catalogue{nullptr};
+            std::vector<int> object_ids{};
+            bool whole_catalogue{false};
 
+            const std::vector<int>& ids()const{return whole_catalogue ? source_catalogue->object_id_column : object_ids;}
+
+        public:
+            class iterator
+            {
+                /* Iterates over the objects of a selection in the order they were selected. */
+                private:
+                    catalogue* source_catalogue{nullptr};
+                    std::vector<int>::const_iterator id_position{};
+
+                public:
+                    using iterator_category = std::forward_iterator_tag;
+                    using value_type = celestial_object;
+                    using difference_type = std::ptrdiff_t;
+                    using pointer = celestial_object*;
+                    using reference = celestial_object&;
+
+                    iterator() = default;
+                    iterator(catalogue* source, std::vector<int>::const_iterator position):source_catalogue(source), id_position(position){}
+
+                    celestial_object& operator*()const
+                    {return *source_catalogue->catalogue_objects[source_catalogue->object_positions[*id_position]];}
+                    celestial_object* operator->()const{return &**this;}
+                    iterator& operator++(){++id_position; return *this;}
+                    iterator operator++(int){iterator previous{*this}; ++id_position; return previous;}
+                    bool operator==(const iterator& other)const{return id_position == other.id_position;}
+                    bool operator!=(const iterator& other)const{return id_position != other.id_position;}
+            };
+
+            catalogue_selection() = default;
+            catalogue_selection(catalogue* source, std::vector<int> ids):source_catalogue(source), object_ids(std::move(ids)){}
+            //Selects the whole of the given catalogue without copying its ids
+            explicit catalogue_selection(catalogue* source):source_catalogue(source), whole_catalogue(true){}
+
+            iterator begin()const{return iterator(source_catalogue, ids().begin());}
+            iterator end()const{return iterator(source_catalogue, ids().end());}
+            int size()const{return int(ids().size());}
+            bool empty()const{return ids().empty();}
+            void clear(){source_catalogue = nullptr; object_ids.clear(); whole_catalogue = false;}
+            catalogue* get_catalogue()const{return source_catalogue;}
+            //Rebinds the selection to a copy of its catalogue, which holds the same objects under the same ids
+            void set_catalogue(catalogue* source){source_catalogue = source;}
+
+            celestial_object& operator[](int index)const
+            {return *source_catalogue->catalogue_objects[source_catalogue->object_positions[ids()[index]]];}
+            //Gives the current position within the catalogue of the object at the given index of the selection
+            int position(int index)const{return source_catalogue->object_positions[ids()[index]];}
     };
 
-    bool name_sort(std::string name_a, std::string name_b);
+    bool name_sort(const std::string& name_a, const std::string& name_b);
+    std::uint64_t hash_name(std::string_view name);
     bool numerical_sort(int& a, int& b);
     bool numerical_sort(double& a, double& b);
     bool hubble_sort(celestial_objects::hubble_types& hubtype_a, celestial_objects::hubble_types& hubtype_b);
     bool stellar_sort(celestial_objects::stellar_types& steltype_a, celestial_objects::stellar_types& steltype_b);
+
+    int choose_worker_count(std::size_t work_size, std::size_t minimum_work_per_worker);
+    std::uint64_t name_prefix_key(const std::string& sort_key);
+    std::uint64_t radix_key(double value);
+    std::uint64_t radix_key(int value);
+    void radix_sort(std::vector<std::uint64_t>& keys, std::vector<int>& items);
+    void counting_sort(const std::vector<int>& keys, int minimum_key, int maximum_key, std::vector<int>& items);
+    std::uint32_t nested_pixel(std::uint32_t row, std::uint32_t column, int level);
+    std::uint32_t sky_pixel(double right_ascension, double declination, int level);
+    bool valid_sky_position(double right_ascension, double declination);
+
+    template<typename T, typename Compare>
+    void parallel_sort(std::vector<T>& items, Compare compare)
+    {
+        /* Sorts items with a merge sort split across the available cores. Each worker sorts one run, then neighbouring runs are
+        merged in pairs, on separate threads, until one run is left. The comparison must be a strict total order, so that the
+        result does not depend on how the items were split. */
+        int worker_number{choose_worker_count(items.size(), 1 << 16)};
+        if(worker_number <= 1){
+            std::sort(items.begin(), items.end(), compare);
+            return;
+        }
+        std::vector<std::size_t> run_bounds(worker_number + 1);
+        for(int i{0}; i <= worker_number; i++){
+            run_bounds[i] = items.size() * std::size_t(i) / std::size_t(worker_number);
+        }
+        std::vector<std::thread> workers;
+        for(int i{1}; i < worker_number; i++){
+            workers.emplace_back([&items, &run_bounds, &compare, i]()
+            {std::sort(items.begin() + run_bounds[i], items.begin() + run_bounds[i + 1], compare);});
+        }
+        std::sort(items.begin(), items.begin() + run_bounds[1], compare);
+        for(std::thread& worker : workers){
+            worker.join();
+        }
+
+        std::vector<T> merged_items(items.size());
+        while(run_bounds.size() > 2){
+            std::size_t run_number{run_bounds.size() - 1};
+            std::vector<std::size_t> merged_bounds;
+            std::vector<std::thread> mergers;
+            for(std::size_t run{0}; run < run_number; run += 2){
+                merged_bounds.push_back(run_bounds[run]);
+                if(run + 1 < run_number){
+                    std::size_t begin{run_bounds[run]};
+                    std::size_t middle{run_bounds[run + 1]};
+                    std::size_t end{run_bounds[run + 2]};
+                    mergers.emplace_back([&items, &merged_items, &compare, begin, middle, end]()
+                    {std::merge(items.begin() + begin, items.begin() + middle, items.begin() + middle, items.begin() + end,
+                    merged_items.begin() + begin, compare);});
+                } else{
+                    //An odd run out is carried over to the next round unchanged
+                    std::copy(items.begin() + run_bounds[run], items.begin() + run_bounds[run + 1], merged_items.begin() + run_bounds[run]);
+                }
+            }
+            merged_bounds.push_back(items.size());
+            for(std::thread& merger : mergers){
+                merger.join();
+            }
+            items.swap(merged_items);
+            run_bounds.swap(merged_bounds);
+        }
+    }
+
+    template<typename T>
+    void permute_column(std::vector<T>& column, const std::vector<int>& order)
+    {
+        //Reorders a column so that the element at position i is the one previously at order[i]
+        std::vector<T> permuted_column;
+        permuted_column.reserve(column.size());
+        for(int position : order){
+            permuted_column.push_back(std::move(column[position]));
+        }
+        column.swap(permuted_column);
+    }
+    bool is_stellar_type(celestial_types type);
+    std::string timestamp_string();
+    std::string relationship_file_name(const std::string& object_file_name);
+    std::string operation_log_file_name(const std::string& object_file_name);
+    int delta_sequence(std::string_view file_text);
+    void write_binary_column(std::ofstream& file, const void* data, std::size_t bytes);
+
+    //Allocation-free parsing helpers for the colon-delimited catalogue files
+    bool next_line(std::string_view& text, std::string_view& line);
+    std::size_t split_fields(std::string_view line, std::array<std::string_view, max_line_fields>& fields);
+    double parse_double(std::string_view field);
+    int parse_int(std::string_view field);
+    int find_output_position(const std::vector<std::string>& outputs, std::string_view field);
+    int parse_output_field(const std::vector<std::string>& outputs, std::string_view field, const char* field_name);
 }
 
 #endif
\ No newline at end of file